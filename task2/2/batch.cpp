@@ -0,0 +1,141 @@
+#include <cstdlib>
+#include <omp.h>
+#include <time.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <vector>
+#include <cmath>
+
+#define NUM_THREADS 40
+#define PI 3.14159265358979323846
+#define NUM_JOBS 4000
+#define CHUNK_STEPS 16384 /* steps per scheduled sub-interval */
+
+/* integrands take a per-job parameter so one function can serve a whole family of jobs */
+typedef double (*integrand_t)(double x, double p);
+
+struct IntegralJob {
+    integrand_t func;
+    double p;
+    double a;
+    double b;
+    int64_t n;
+};
+
+double gauss(double x, double p) {
+    return exp(-p * x * x);
+}
+
+double integrate_omp(integrand_t func, double p, double a, double b, int64_t n) {
+    double h = (b - a) / n;
+    double sum = 0.0;
+
+    #pragma omp parallel num_threads(NUM_THREADS)
+    {
+        int nthreads = omp_get_num_threads();
+        int threadid = omp_get_thread_num();
+        int64_t items_per_thread = n / nthreads;
+        int64_t lb = threadid * items_per_thread;
+        int64_t ub = (threadid == nthreads - 1) ? (n - 1) : (lb + items_per_thread - 1);
+        double sumloc = 0.0;
+
+        for (int64_t i = lb; i <= ub; i++)
+            sumloc += func(a + h * (i + 0.5), p);
+
+        #pragma omp atomic
+        sum += sumloc;
+    }
+    sum *= h;
+    return sum;
+}
+
+/*
+ * integrate_batch: midpoint rule for every job in one parallel region.
+ * Each job is cut into sub-intervals of CHUNK_STEPS steps, all sub-intervals of
+ * all jobs are dealt out dynamically, and every partial sum gets its own slot,
+ * so no atomics are needed. The slots are then summed per job.
+ */
+std::vector<double> integrate_batch(const std::vector<IntegralJob> &jobs) {
+    size_t njobs = jobs.size();
+    std::vector<size_t> first_chunk(njobs + 1, 0);
+    for (size_t k = 0; k < njobs; k++)
+        first_chunk[k + 1] = first_chunk[k] + (jobs[k].n + CHUNK_STEPS - 1) / CHUNK_STEPS;
+
+    size_t nchunks = first_chunk[njobs];
+    std::vector<size_t> chunk_job(nchunks);
+    for (size_t k = 0; k < njobs; k++)
+        for (size_t c = first_chunk[k]; c < first_chunk[k + 1]; c++)
+            chunk_job[c] = k;
+
+    std::vector<double> partial(nchunks);
+    std::vector<double> results(njobs);
+
+    #pragma omp parallel num_threads(NUM_THREADS)
+    {
+        #pragma omp for schedule(dynamic)
+        for (size_t c = 0; c < nchunks; c++) {
+            const IntegralJob &job = jobs[chunk_job[c]];
+            double h = (job.b - job.a) / job.n;
+            int64_t lb = (int64_t)(c - first_chunk[chunk_job[c]]) * CHUNK_STEPS;
+            int64_t ub = (lb + CHUNK_STEPS < job.n) ? lb + CHUNK_STEPS : job.n;
+            double sumloc = 0.0;
+
+            for (int64_t i = lb; i < ub; i++)
+                sumloc += job.func(job.a + h * (i + 0.5), job.p);
+            partial[c] = sumloc;
+        }
+
+        #pragma omp for schedule(static)
+        for (size_t k = 0; k < njobs; k++) {
+            double sum = 0.0;
+            for (size_t c = first_chunk[k]; c < first_chunk[k + 1]; c++)
+                sum += partial[c];
+            results[k] = sum * (jobs[k].b - jobs[k].a) / jobs[k].n;
+        }
+    }
+    return results;
+}
+
+int main(int argc, char **argv) {
+    const int njobs = (argc > 1) ? atoi(argv[1]) : NUM_JOBS;
+    if (njobs <= 0) {
+        printf("Error: the number of jobs must be greater than 0\n");
+        return 1;
+    }
+    std::vector<IntegralJob> jobs(njobs);
+
+    /* mixed sizes so that load balancing matters: n from 1000 to ~200000 */
+    srand(1);
+    for (int k = 0; k < njobs; k++) {
+        double b = 1.0 + 3.0 * rand() / RAND_MAX;
+        jobs[k].func = gauss;
+        jobs[k].p = 0.5 + 2.0 * rand() / RAND_MAX;
+        jobs[k].a = -b;
+        jobs[k].b = b;
+        jobs[k].n = 1000 + rand() % 200000;
+    }
+
+    printf("Integrating %d jobs\n", njobs);
+
+    double t = omp_get_wtime();
+    std::vector<double> single(njobs);
+    for (int k = 0; k < njobs; k++)
+        single[k] = integrate_omp(jobs[k].func, jobs[k].p, jobs[k].a, jobs[k].b, jobs[k].n);
+    double tsingle = omp_get_wtime() - t;
+
+    t = omp_get_wtime();
+    std::vector<double> batch = integrate_batch(jobs);
+    double tbatch = omp_get_wtime() - t;
+
+    double maxdiff = 0.0;
+    for (int k = 0; k < njobs; k++)
+        maxdiff = fmax(maxdiff, fabs(single[k] - batch[k]));
+    /* sanity check against the closed form for the first job */
+    printf("Job 0: %.12f; exact %.12f\n", batch[0], sqrt(PI / jobs[0].p) * erf(sqrt(jobs[0].p) * jobs[0].b));
+    printf("Max difference (per-call vs batch): %.3e\n", maxdiff);
+
+    printf("Execution time (integrate_omp per job): %.6f\n", tsingle);
+    printf("Execution time (batch): %.6f\n", tbatch);
+    printf("Speedup: %.2f\n", tsingle / tbatch);
+    return 0;
+}
@@ -0,0 +1,379 @@
+#include <cstdlib>
+#include <omp.h>
+#include <time.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <ctype.h>
+#include <vector>
+#include <cmath>
+
+#define NUM_THREADS 40
+#define BATCH 256 /* x values evaluated per instruction */
+
+double func(double x) {
+    return exp(-x * x);
+}
+
+double integrate_omp(double (*func)(double), double a, double b, int64_t n) {
+    double h = (b - a) / n;
+    double sum = 0.0;
+
+    #pragma omp parallel num_threads(NUM_THREADS)
+    {
+        int nthreads = omp_get_num_threads();
+        int threadid = omp_get_thread_num();
+        int64_t items_per_thread = n / nthreads;
+        int64_t lb = threadid * items_per_thread;
+        int64_t ub = (threadid == nthreads - 1) ? (n - 1) : (lb + items_per_thread - 1);
+        double sumloc = 0.0;
+
+        for (int64_t i = lb; i <= ub; i++)
+            sumloc += func(a + h * (i + 0.5));
+
+        #pragma omp atomic
+        sum += sumloc;
+    }
+    sum *= h;
+    return sum;
+}
+
+/*
+ * Bytecode: every instruction writes one register, registers are BATCH-wide
+ * arrays of doubles. Register 0 always holds x. Constants are loaded once
+ * per batch by OP_CONST, which keeps the instruction format fixed.
+ */
+enum Opcode {
+    OP_CONST, OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_POW, OP_NEG,
+    OP_EXP, OP_LOG, OP_SQRT, OP_SIN, OP_COS, OP_TAN, OP_ABS
+};
+
+struct Instr {
+    uint8_t op;
+    uint8_t dst;
+    uint8_t a;
+    uint8_t b;
+    double value; /* OP_CONST only */
+};
+
+struct Program {
+    std::vector<Instr> code;
+    int nregs;
+    int result;
+};
+
+struct Function {
+    const char *name;
+    Opcode op;
+};
+
+static const Function functions[] = {
+    {"exp", OP_EXP}, {"log", OP_LOG}, {"sqrt", OP_SQRT}, {"sin", OP_SIN},
+    {"cos", OP_COS}, {"tan", OP_TAN}, {"abs", OP_ABS},
+};
+
+/*
+ * Recursive descent parser:
+ *   expr   := term (('+' | '-') term)*
+ *   term   := unary (('*' | '/') unary)*
+ *   unary  := '-' unary | power
+ *   power  := atom ('^' unary)?
+ *   atom   := number | 'x' | 'pi' | name '(' expr ')' | 'pow' '(' expr ',' expr ')' | '(' expr ')'
+ * Each method returns the register holding the value or -1 on error.
+ */
+struct Parser {
+    const char *s;
+    const char *error;
+    Program *prog;
+
+    void skip() {
+        while (isspace((unsigned char)*s))
+            s++;
+    }
+
+    int emit(Opcode op, int a, int b, double value) {
+        if (prog->nregs >= 255) {
+            error = "expression too long";
+            return -1;
+        }
+        Instr ins = {(uint8_t)op, (uint8_t)prog->nregs, (uint8_t)a, (uint8_t)b, value};
+        prog->code.push_back(ins);
+        return prog->nregs++;
+    }
+
+    bool expect(char c) {
+        skip();
+        if (*s != c) {
+            error = (c == ')') ? "expected ')'" : (c == '(') ? "expected '('" : "expected ','";
+            return false;
+        }
+        s++;
+        return true;
+    }
+
+    int atom() {
+        skip();
+        if (isdigit((unsigned char)*s) || *s == '.') {
+            char *end;
+            double v = strtod(s, &end);
+            s = end;
+            return emit(OP_CONST, 0, 0, v);
+        }
+        if (*s == '(') {
+            s++;
+            int r = expr();
+            if (r < 0 || !expect(')'))
+                return -1;
+            return r;
+        }
+        if (isalpha((unsigned char)*s)) {
+            const char *start = s;
+            while (isalnum((unsigned char)*s))
+                s++;
+            size_t len = s - start;
+
+            if (len == 1 && *start == 'x')
+                return 0;
+            if (len == 2 && strncmp(start, "pi", 2) == 0)
+                return emit(OP_CONST, 0, 0, M_PI);
+            if (len == 3 && strncmp(start, "pow", 3) == 0) {
+                if (!expect('('))
+                    return -1;
+                int a = expr();
+                if (a < 0 || !expect(','))
+                    return -1;
+                int b = expr();
+                if (b < 0 || !expect(')'))
+                    return -1;
+                return emit(OP_POW, a, b, 0.0);
+            }
+            for (const Function &f : functions) {
+                if (strlen(f.name) == len && strncmp(start, f.name, len) == 0) {
+                    if (!expect('('))
+                        return -1;
+                    int a = expr();
+                    if (a < 0 || !expect(')'))
+                        return -1;
+                    return emit(f.op, a, 0, 0.0);
+                }
+            }
+            error = "unknown name";
+            s = start;
+            return -1;
+        }
+        error = "unexpected character";
+        return -1;
+    }
+
+    int power() {
+        int a = atom();
+        if (a < 0)
+            return -1;
+        skip();
+        if (*s == '^') {
+            s++;
+            int b = unary();
+            if (b < 0)
+                return -1;
+            return emit(OP_POW, a, b, 0.0);
+        }
+        return a;
+    }
+
+    int unary() {
+        skip();
+        if (*s == '-') {
+            s++;
+            int a = unary();
+            if (a < 0)
+                return -1;
+            return emit(OP_NEG, a, 0, 0.0);
+        }
+        if (*s == '+')
+            s++;
+        return power();
+    }
+
+    int term() {
+        int a = unary();
+        while (a >= 0) {
+            skip();
+            if (*s != '*' && *s != '/')
+                break;
+            Opcode op = (*s == '*') ? OP_MUL : OP_DIV;
+            s++;
+            int b = unary();
+            if (b < 0)
+                return -1;
+            a = emit(op, a, b, 0.0);
+        }
+        return a;
+    }
+
+    int expr() {
+        int a = term();
+        while (a >= 0) {
+            skip();
+            if (*s != '+' && *s != '-')
+                break;
+            Opcode op = (*s == '+') ? OP_ADD : OP_SUB;
+            s++;
+            int b = term();
+            if (b < 0)
+                return -1;
+            a = emit(op, a, b, 0.0);
+        }
+        return a;
+    }
+};
+
+/*
+ * compile: translate text into a Program. On failure returns false and
+ * sets *error and *pos (offset of the offending character).
+ */
+bool compile(const char *text, Program *prog, const char **error, int *pos) {
+    Parser p = {text, NULL, prog};
+    prog->code.clear();
+    prog->nregs = 1;
+
+    int r = p.expr();
+    p.skip();
+    if (r >= 0 && *p.s != '\0') {
+        p.error = "unexpected trailing input";
+        r = -1;
+    }
+    if (r < 0) {
+        *error = p.error;
+        *pos = (int)(p.s - text);
+        return false;
+    }
+    prog->result = r;
+    return true;
+}
+
+/*
+ * run: evaluate prog for BATCH x values stored in regs[0 .. BATCH).
+ * One dispatch per instruction, then a simd loop over all lanes,
+ * so the interpretation cost is spread across the batch.
+ */
+void run(const Program &prog, double *regs, int count) {
+    for (const Instr &ins : prog.code) {
+        double *d = regs + ins.dst * BATCH;
+        const double *a = regs + ins.a * BATCH;
+        const double *b = regs + ins.b * BATCH;
+        switch (ins.op) {
+        case OP_CONST:
+            #pragma omp simd
+            for (int k = 0; k < count; k++) d[k] = ins.value;
+            break;
+        case OP_ADD:
+            #pragma omp simd
+            for (int k = 0; k < count; k++) d[k] = a[k] + b[k];
+            break;
+        case OP_SUB:
+            #pragma omp simd
+            for (int k = 0; k < count; k++) d[k] = a[k] - b[k];
+            break;
+        case OP_MUL:
+            #pragma omp simd
+            for (int k = 0; k < count; k++) d[k] = a[k] * b[k];
+            break;
+        case OP_DIV:
+            #pragma omp simd
+            for (int k = 0; k < count; k++) d[k] = a[k] / b[k];
+            break;
+        case OP_POW:
+            for (int k = 0; k < count; k++) d[k] = pow(a[k], b[k]);
+            break;
+        case OP_NEG:
+            #pragma omp simd
+            for (int k = 0; k < count; k++) d[k] = -a[k];
+            break;
+        case OP_EXP:
+            #pragma omp simd
+            for (int k = 0; k < count; k++) d[k] = exp(a[k]);
+            break;
+        case OP_LOG:
+            #pragma omp simd
+            for (int k = 0; k < count; k++) d[k] = log(a[k]);
+            break;
+        case OP_SQRT:
+            #pragma omp simd
+            for (int k = 0; k < count; k++) d[k] = sqrt(a[k]);
+            break;
+        case OP_SIN:
+            #pragma omp simd
+            for (int k = 0; k < count; k++) d[k] = sin(a[k]);
+            break;
+        case OP_COS:
+            #pragma omp simd
+            for (int k = 0; k < count; k++) d[k] = cos(a[k]);
+            break;
+        case OP_TAN:
+            for (int k = 0; k < count; k++) d[k] = tan(a[k]);
+            break;
+        case OP_ABS:
+            #pragma omp simd
+            for (int k = 0; k < count; k++) d[k] = fabs(a[k]);
+            break;
+        }
+    }
+}
+
+/* integrate_expr: midpoint rule for a compiled expression, each thread with its own register file */
+double integrate_expr(const Program &prog, double a, double b, int64_t n) {
+    double h = (b - a) / n;
+    double sum = 0.0;
+
+    #pragma omp parallel num_threads(NUM_THREADS) reduction(+:sum)
+    {
+        std::vector<double> regs((size_t)prog.nregs * BATCH);
+        double *x = regs.data();
+        const double *y = regs.data() + (size_t)prog.result * BATCH;
+
+        #pragma omp for schedule(static)
+        for (int64_t lb = 0; lb < n; lb += BATCH) {
+            int count = (n - lb < BATCH) ? (int)(n - lb) : BATCH;
+            for (int k = 0; k < count; k++)
+                x[k] = a + h * (lb + k + 0.5);
+            run(prog, regs.data(), count);
+            for (int k = 0; k < count; k++)
+                sum += y[k];
+        }
+    }
+    return sum * h;
+}
+
+int main(int argc, char **argv) {
+    const double a = (argc > 2) ? atof(argv[2]) : -4.0; /* [a, b] */
+    const double b = (argc > 3) ? atof(argv[3]) : 4.0;
+    const int64_t nsteps = (argc > 4) ? strtoll(argv[4], NULL, 10) : 40000000; /* n */
+    const char *text = (argc > 1) ? argv[1] : "exp(-x*x)";
+
+    Program prog;
+    const char *error;
+    int pos;
+    if (!compile(text, &prog, &error, &pos)) {
+        printf("Error: %s at position %d\n  %s\n  %*s^\n", error, pos, text, pos, "");
+        return 1;
+    }
+
+    printf("Integration f(x) = %s on [%.12f, %.12f], nsteps = %" PRId64 "\n", text, a, b, nsteps);
+    printf("Bytecode: %zu instructions, %d registers\n", prog.code.size(), prog.nregs);
+
+    double t = omp_get_wtime();
+    double res = integrate_expr(prog, a, b, nsteps);
+    double texpr = omp_get_wtime() - t;
+    printf("Result (expression): %.12f\n", res);
+
+    /* the compiled func is exp(-x*x), so the comparison only makes sense for that integrand */
+    t = omp_get_wtime();
+    double ref = integrate_omp(func, a, b, nsteps);
+    double tfunc = omp_get_wtime() - t;
+    printf("Result (compiled func): %.12f\n", ref);
+
+    printf("Execution time (compiled func): %.6f\n", tfunc);
+    printf("Execution time (expression): %.6f\n", texpr);
+    printf("Overhead: %.2f\n", texpr / tfunc);
+    return 0;
+}
@@ -8,23 +8,25 @@
 
 #define NUM_THREADS 40
 #define PI 3.14159265358979323846
+#define CHUNK_STEPS (1 << 20) /* steps per block in the chunked mode */
+#define REPORT_INTERVAL 1.0 /* seconds between progress reports */
 
 double func(double x) {
     return exp(-x * x);
 }
 
-double integrate(double a, double b, int n) {
+double integrate(double a, double b, int64_t n) {
     double h = (b - a) / n;
     double sum = 0.0;
 
-    for (int i = 0; i < n; i++)
+    for (int64_t i = 0; i < n; i++)
         sum += func(a + h * (i + 0.5));
     
     sum *= h;
     return sum;
 }
 
-double integrate_omp(double (*func)(double), double a, double b, int n) {
+double integrate_omp(double (*func)(double), double a, double b, int64_t n) {
     double h = (b - a) / n;
     double sum = 0.0;
 
@@ -32,12 +34,12 @@ double integrate_omp(double (*func)(double), double a, double b, int n) {
     {
         int nthreads = omp_get_num_threads();
         int threadid = omp_get_thread_num();
-        int items_per_thread = n / nthreads;
-        int lb = threadid * items_per_thread;
-        int ub = (threadid == nthreads - 1) ? (n - 1) : (lb + items_per_thread - 1);
+        int64_t items_per_thread = n / nthreads;
+        int64_t lb = threadid * items_per_thread;
+        int64_t ub = (threadid == nthreads - 1) ? (n - 1) : (lb + items_per_thread - 1);
         double sumloc = 0.0; // local sum variable for each thread
 
-        for (int i = lb; i <= ub; i++)
+        for (int64_t i = lb; i <= ub; i++)
             sumloc += func(a + h * (i + 0.5));
         
         // without "omp critical" or "omp atomic" there will be so called "race conditions" when many of threads
@@ -50,7 +52,58 @@ double integrate_omp(double (*func)(double), double a, double b, int n) {
     return sum;
 }
 
-double run_serial(double a, double b, int nsteps) {
+/*
+ * progress_t: called between blocks of the chunked mode with the number of steps
+ * done so far and the integral over [a, a + done * h]. Returning false stops the run.
+ */
+typedef bool (*progress_t)(int64_t done, int64_t n, double partial);
+
+/*
+ * integrate_omp_chunked: same midpoint rule as integrate_omp, but the steps are
+ * processed in blocks of CHUNK_STEPS inside one parallel region. Between blocks
+ * the master thread hands the partial result to progress (at most once per
+ * REPORT_INTERVAL seconds) and may stop the run early. *done receives the number
+ * of steps actually summed; on early stop the result covers only those steps.
+ */
+double integrate_omp_chunked(double (*func)(double), double a, double b, int64_t n,
+                             progress_t progress, int64_t *done) {
+    double h = (b - a) / n;
+    double sum = 0.0;
+    double last_report = omp_get_wtime();
+    bool stop = false;
+    int64_t lb = 0;
+
+    #pragma omp parallel num_threads(NUM_THREADS)
+    {
+        while (lb < n && !stop) {
+            int64_t ub = (n - lb > CHUNK_STEPS) ? lb + CHUNK_STEPS : n;
+
+            #pragma omp for reduction(+:sum)
+            for (int64_t i = lb; i < ub; i++)
+                sum += func(a + h * (i + 0.5));
+
+            #pragma omp single
+            {
+                lb = ub;
+                double now = omp_get_wtime();
+                if (progress != NULL && lb < n && now - last_report >= REPORT_INTERVAL) {
+                    last_report = now;
+                    stop = !progress(lb, n, sum * h);
+                }
+            }
+        }
+    }
+    *done = lb;
+    return sum * h;
+}
+
+bool print_progress(int64_t done, int64_t n, double partial) {
+    printf("  %6.2f%% (%" PRId64 " / %" PRId64 "): partial %.12f\n", 100.0 * done / n, done, n, partial);
+    fflush(stdout);
+    return true;
+}
+
+double run_serial(double a, double b, int64_t nsteps) {
     double t = omp_get_wtime();
     double res = integrate(a, b, nsteps);
     t = omp_get_wtime() - t;
@@ -58,7 +111,7 @@ double run_serial(double a, double b, int nsteps) {
     return t;
 }
 
-double run_parallel(double a, double b, int nsteps) {
+double run_parallel(double a, double b, int64_t nsteps) {
     double t = omp_get_wtime();
     double res = integrate_omp(func, a, b, nsteps);
     t = omp_get_wtime() - t;
@@ -66,17 +119,29 @@ double run_parallel(double a, double b, int nsteps) {
     return t;
 }
 
+double run_chunked(double a, double b, int64_t nsteps) {
+    int64_t done;
+    double t = omp_get_wtime();
+    double res = integrate_omp_chunked(func, a, b, nsteps, print_progress, &done);
+    t = omp_get_wtime() - t;
+    printf("Result (chunked): %.12f; error %.12f\n", res, fabs(res - sqrt(PI)));
+    return t;
+}
+
 int main(int argc, char **argv) {
     const double a = -4.0; /* [a, b] */
     const double b = 4.0;
-    const int nsteps = 40000000; /* n */
+    const int64_t nsteps = (argc > 1) ? strtoll(argv[1], NULL, 10) : 40000000; /* n, may exceed INT_MAX */
 
-    printf("Integration f(x) on [%.12f, %.12f], nsteps = %d\n", a, b, nsteps);
+    printf("Integration f(x) on [%.12f, %.12f], nsteps = %" PRId64 "\n", a, b, nsteps);
     double tserial = run_serial(a, b, nsteps);
     double tparallel = run_parallel(a, b, nsteps);
+    double tchunked = run_chunked(a, b, nsteps);
 
     printf("Execution time (serial): %.6f\n", tserial);
     printf("Execution time (parallel): %.6f\n", tparallel);
+    printf("Execution time (chunked): %.6f\n", tchunked);
     printf("Speedup: %.2f\n", tserial / tparallel);
+    printf("Speedup (chunked): %.2f\n", tserial / tchunked);
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,138 @@
+#include <cstdlib>
+#include <omp.h>
+#include <time.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <vector>
+#include <cmath>
+
+#define NUM_THREADS 40
+#define PI 3.14159265358979323846
+#define MAX_MOMENTS 8
+
+double func(double x) {
+    return exp(-x * x);
+}
+
+double x_func(double x) {
+    return x * func(x);
+}
+
+double x2_func(double x) {
+    return x * x * func(x);
+}
+
+double integrate_omp(double (*func)(double), double a, double b, int64_t n) {
+    double h = (b - a) / n;
+    double sum = 0.0;
+
+    #pragma omp parallel num_threads(NUM_THREADS)
+    {
+        int nthreads = omp_get_num_threads();
+        int threadid = omp_get_thread_num();
+        int64_t items_per_thread = n / nthreads;
+        int64_t lb = threadid * items_per_thread;
+        int64_t ub = (threadid == nthreads - 1) ? (n - 1) : (lb + items_per_thread - 1);
+        double sumloc = 0.0;
+
+        for (int64_t i = lb; i <= ub; i++)
+            sumloc += func(a + h * (i + 0.5));
+
+        #pragma omp atomic
+        sum += sumloc;
+    }
+    sum *= h;
+    return sum;
+}
+
+/*
+ * moments_kernel: sums f(x) * x^k for k < K over [lb, ub] of one thread.
+ * K is a template parameter so the loop over k is unrolled and the K
+ * accumulators stay in registers; f is evaluated once per point.
+ */
+template <int K>
+void moments_kernel(double (*func)(double), double a, double h, int64_t lb, int64_t ub, double *out) {
+    double acc[K];
+    for (int k = 0; k < K; k++)
+        acc[k] = 0.0;
+
+    for (int64_t i = lb; i <= ub; i++) {
+        double x = a + h * (i + 0.5);
+        double w = func(x);
+        for (int k = 0; k < K; k++) {
+            acc[k] += w;
+            w *= x;
+        }
+    }
+    for (int k = 0; k < K; k++)
+        out[k] = acc[k];
+}
+
+/*
+ * integrate_moments: returns the K integrals of x^k * f(x), k = 0 .. K-1, over [a, b]
+ * from a single pass of the midpoint rule. K is capped at MAX_MOMENTS.
+ */
+std::vector<double> integrate_moments(double (*func)(double), double a, double b, int64_t n, int K) {
+    if (K > MAX_MOMENTS)
+        K = MAX_MOMENTS;
+    double h = (b - a) / n;
+    std::vector<double> sum(K, 0.0);
+
+    #pragma omp parallel num_threads(NUM_THREADS)
+    {
+        int nthreads = omp_get_num_threads();
+        int threadid = omp_get_thread_num();
+        int64_t items_per_thread = n / nthreads;
+        int64_t lb = threadid * items_per_thread;
+        int64_t ub = (threadid == nthreads - 1) ? (n - 1) : (lb + items_per_thread - 1);
+        double sumloc[MAX_MOMENTS];
+
+        switch (K) {
+        case 1: moments_kernel<1>(func, a, h, lb, ub, sumloc); break;
+        case 2: moments_kernel<2>(func, a, h, lb, ub, sumloc); break;
+        case 3: moments_kernel<3>(func, a, h, lb, ub, sumloc); break;
+        case 4: moments_kernel<4>(func, a, h, lb, ub, sumloc); break;
+        case 5: moments_kernel<5>(func, a, h, lb, ub, sumloc); break;
+        case 6: moments_kernel<6>(func, a, h, lb, ub, sumloc); break;
+        case 7: moments_kernel<7>(func, a, h, lb, ub, sumloc); break;
+        default: moments_kernel<8>(func, a, h, lb, ub, sumloc); break;
+        }
+
+        for (int k = 0; k < K; k++) {
+            #pragma omp atomic
+            sum[k] += sumloc[k];
+        }
+    }
+    for (int k = 0; k < K; k++)
+        sum[k] *= h;
+    return sum;
+}
+
+int main(int argc, char **argv) {
+    const double a = -4.0; /* [a, b] */
+    const double b = 4.0;
+    const int64_t nsteps = (argc > 1) ? strtoll(argv[1], NULL, 10) : 40000000; /* n */
+    const int K = 3;
+
+    printf("Moments of f(x) on [%.12f, %.12f], nsteps = %" PRId64 "\n", a, b, nsteps);
+
+    double t = omp_get_wtime();
+    double m0 = integrate_omp(func, a, b, nsteps);
+    double m1 = integrate_omp(x_func, a, b, nsteps);
+    double m2 = integrate_omp(x2_func, a, b, nsteps);
+    double tseparate = omp_get_wtime() - t;
+
+    t = omp_get_wtime();
+    std::vector<double> m = integrate_moments(func, a, b, nsteps, K);
+    double tfused = omp_get_wtime() - t;
+
+    /* for exp(-x*x) on a symmetric range: m0 = sqrt(pi), m1 = 0, m2 = sqrt(pi) / 2 (up to the tails) */
+    printf("Result (separate): %.12f %.12f %.12f\n", m0, m1, m2);
+    printf("Result (fused):    %.12f %.12f %.12f\n", m[0], m[1], m[2]);
+    printf("Expected:          %.12f %.12f %.12f\n", sqrt(PI), 0.0, sqrt(PI) / 2);
+
+    printf("Execution time (3 x integrate_omp): %.6f\n", tseparate);
+    printf("Execution time (fused): %.6f\n", tfused);
+    printf("Speedup: %.2f\n", tseparate / tfused);
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <cstdlib>
+#include <omp.h>
+#include <time.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <vector>
+#include <cmath>
+
+#define NUM_THREADS 40
+#define PI 3.14159265358979323846
+#define MAX_LEVELS 30
+#define PARALLEL_THRESHOLD 4096 /* below this many new points a parallel region costs more than it saves */
+
+double func(double x) {
+    return exp(-x * x);
+}
+
+double integrate_omp(double (*func)(double), double a, double b, int64_t n) {
+    double h = (b - a) / n;
+    double sum = 0.0;
+
+    #pragma omp parallel num_threads(NUM_THREADS)
+    {
+        int nthreads = omp_get_num_threads();
+        int threadid = omp_get_thread_num();
+        int64_t items_per_thread = n / nthreads;
+        int64_t lb = threadid * items_per_thread;
+        int64_t ub = (threadid == nthreads - 1) ? (n - 1) : (lb + items_per_thread - 1);
+        double sumloc = 0.0;
+
+        for (int64_t i = lb; i <= ub; i++)
+            sumloc += func(a + h * (i + 0.5));
+
+        #pragma omp atomic
+        sum += sumloc;
+    }
+    sum *= h;
+    return sum;
+}
+
+/*
+ * midpoint_sum: sum of f over the n midpoints of [a, b] split into n cells.
+ * These are exactly the points that the next trapezoid level (2n cells) adds,
+ * so every evaluation made here is reused by all later levels.
+ */
+double midpoint_sum(double (*func)(double), double a, double b, int64_t n) {
+    double h = (b - a) / n;
+    double sum = 0.0;
+
+    #pragma omp parallel for reduction(+:sum) num_threads(NUM_THREADS) if(n >= PARALLEL_THRESHOLD)
+    for (int64_t i = 0; i < n; i++)
+        sum += func(a + h * (i + 0.5));
+
+    return sum;
+}
+
+/*
+ * integrate_romberg: Romberg integration with early stop.
+ * Level k is the trapezoid rule on 2^k cells, built from level k-1 plus the
+ * 2^(k-1) new midpoints, then Richardson-extrapolated along the row.
+ * Stops once two successive diagonal entries differ by less than tol.
+ * On return *nevals holds the number of function evaluations actually used.
+ */
+double integrate_romberg(double (*func)(double), double a, double b, double tol, int64_t *nevals, int *nlevels) {
+    double R[MAX_LEVELS][MAX_LEVELS];
+    int64_t n = 1;
+
+    R[0][0] = 0.5 * (b - a) * (func(a) + func(b));
+    *nevals = 2;
+
+    int k;
+    for (k = 1; k < MAX_LEVELS; k++) {
+        double h = (b - a) / n;
+        R[k][0] = 0.5 * R[k - 1][0] + 0.5 * h * midpoint_sum(func, a, b, n);
+        *nevals += n;
+        n *= 2;
+
+        double factor = 1.0;
+        for (int j = 1; j <= k; j++) {
+            factor *= 4.0;
+            R[k][j] = R[k][j - 1] + (R[k][j - 1] - R[k - 1][j - 1]) / (factor - 1.0);
+        }
+
+        /* require a couple of levels before trusting the estimate, the first ones can agree by accident */
+        if (k >= 4 && fabs(R[k][k] - R[k - 1][k - 1]) < tol)
+            break;
+    }
+    if (k == MAX_LEVELS)
+        k--;
+
+    *nlevels = k + 1;
+    return R[k][k];
+}
+
+double run_parallel(double a, double b, int64_t nsteps) {
+    double t = omp_get_wtime();
+    double res = integrate_omp(func, a, b, nsteps);
+    t = omp_get_wtime() - t;
+    printf("Result (parallel, nsteps = %" PRId64 "): %.12f; error %.12e\n", nsteps, res, fabs(res - sqrt(PI)));
+    return t;
+}
+
+double run_romberg(double a, double b, double tol) {
+    int64_t nevals;
+    int nlevels;
+    double t = omp_get_wtime();
+    double res = integrate_romberg(func, a, b, tol, &nevals, &nlevels);
+    t = omp_get_wtime() - t;
+    printf("Result (romberg, tol = %.1e): %.12f; error %.12e; levels %d; evaluations %" PRId64 "\n",
+           tol, res, fabs(res - sqrt(PI)), nlevels, nevals);
+    return t;
+}
+
+int main(int argc, char **argv) {
+    const double a = -4.0; /* [a, b] */
+    const double b = 4.0;
+    const int64_t nsteps = 40000000; /* n */
+    const double tol = (argc > 1) ? atof(argv[1]) : 1e-10;
+
+    printf("Integration f(x) on [%.12f, %.12f]\n", a, b);
+    double tparallel = run_parallel(a, b, nsteps);
+    double tromberg = run_romberg(a, b, tol);
+
+    printf("Execution time (parallel): %.6f\n", tparallel);
+    printf("Execution time (romberg): %.6f\n", tromberg);
+    printf("Speedup: %.2f\n", tparallel / tromberg);
+    return 0;
+}
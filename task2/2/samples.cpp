@@ -0,0 +1,182 @@
+#include <cstdlib>
+#include <omp.h>
+#include <time.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <vector>
+#include <cmath>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define NUM_THREADS 40
+#define PI 3.14159265358979323846
+#define WINDOW_BYTES (1L << 30) /* bytes mapped at a time, so files larger than RAM stream through */
+
+double func(double x) {
+    return exp(-x * x);
+}
+
+/*
+ * Sums over the samples in the file, split by the parity of the global index,
+ * which is all that the trapezoid and Simpson rules need.
+ */
+struct SampleSums {
+    double even;
+    double odd;
+    double first;
+    double last;
+    int64_t count;
+};
+
+/*
+ * sum_samples_mmap: maps the file window by window (read-only, no copy) and
+ * sums the even and odd samples of every window in parallel.
+ */
+bool sum_samples_mmap(const char *path, SampleSums *s) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)(2 * sizeof(double))) {
+        close(fd);
+        return false;
+    }
+
+    int64_t count = st.st_size / sizeof(double);
+    double even = 0.0, odd = 0.0;
+
+    for (int64_t first = 0; first < count; first += WINDOW_BYTES / sizeof(double)) {
+        int64_t len = count - first;
+        if (len > (int64_t)(WINDOW_BYTES / sizeof(double)))
+            len = WINDOW_BYTES / sizeof(double);
+
+        void *map = mmap(NULL, len * sizeof(double), PROT_READ, MAP_PRIVATE, fd, first * sizeof(double));
+        if (map == MAP_FAILED) {
+            close(fd);
+            return false;
+        }
+        madvise(map, len * sizeof(double), MADV_SEQUENTIAL);
+        const double *y = (const double *)map;
+
+        /* WINDOW_BYTES is a multiple of 16, so every window starts at an even index */
+        #pragma omp parallel for reduction(+:even, odd) num_threads(NUM_THREADS) schedule(static)
+        for (int64_t i = 0; i < len / 2; i++) {
+            even += y[2 * i];
+            odd += y[2 * i + 1];
+        }
+        if (len % 2 == 1)
+            even += y[len - 1];
+
+        if (first == 0)
+            s->first = y[0];
+        if (first + len == count)
+            s->last = y[len - 1];
+        munmap(map, len * sizeof(double));
+    }
+    close(fd);
+
+    s->even = even;
+    s->odd = odd;
+    s->count = count;
+    return true;
+}
+
+double trapezoid(const SampleSums &s, double h) {
+    return h * (s.even + s.odd - 0.5 * (s.first + s.last));
+}
+
+/*
+ * simpson: composite Simpson over an even number of intervals; with an odd
+ * number of intervals the last one is taken by the trapezoid rule, which needs
+ * the second last sample and is read back from the file.
+ */
+double simpson(const SampleSums &s, double h, double second_last) {
+    int64_t intervals = s.count - 1;
+    if (intervals % 2 == 0)
+        return h / 3.0 * (2.0 * s.even + 4.0 * s.odd - s.first - s.last);
+    /* the last sample has an odd index here, take it out of the odd sum */
+    double simp = h / 3.0 * (2.0 * s.even + 4.0 * (s.odd - s.last) - s.first - second_last);
+    return simp + 0.5 * h * (second_last + s.last);
+}
+
+bool read_sample(const char *path, int64_t index, double *value) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL)
+        return false;
+    bool ok = fseek(f, index * sizeof(double), SEEK_SET) == 0 && fread(value, sizeof(double), 1, f) == 1;
+    fclose(f);
+    return ok;
+}
+
+/* generate: write n samples of func on [a, b] (spacing (b - a) / (n - 1)) as raw doubles */
+bool generate(const char *path, double a, double b, int64_t n) {
+    FILE *f = fopen(path, "wb");
+    if (f == NULL)
+        return false;
+    double h = (b - a) / (n - 1);
+    std::vector<double> buf(1 << 16);
+    for (int64_t i = 0; i < n; i += buf.size()) {
+        int64_t len = (n - i < (int64_t)buf.size()) ? n - i : buf.size();
+        for (int64_t k = 0; k < len; k++)
+            buf[k] = func(a + h * (i + k));
+        if (fwrite(buf.data(), sizeof(double), len, f) != (size_t)len) {
+            fclose(f);
+            return false;
+        }
+    }
+    return fclose(f) == 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc >= 2 && strcmp(argv[1], "generate") == 0) {
+        if (argc < 4) {
+            printf("Usage: %s generate <file> <nsamples>\n", argv[0]);
+            return 1;
+        }
+        int64_t n = strtoll(argv[3], NULL, 10);
+        if (n < 2 || !generate(argv[2], -4.0, 4.0, n)) {
+            printf("Error: could not write %s\n", argv[2]);
+            return 1;
+        }
+        printf("Wrote %" PRId64 " samples of f(x) on [-4, 4] to %s\n", n, argv[2]);
+        return 0;
+    }
+    if (argc < 3) {
+        printf("Usage: %s <file> <h> [trapezoid|simpson]\n", argv[0]);
+        printf("       %s generate <file> <nsamples>\n", argv[0]);
+        return 1;
+    }
+
+    const char *path = argv[1];
+    const double h = atof(argv[2]);
+    const bool use_simpson = (argc > 3) && strcmp(argv[3], "simpson") == 0;
+
+    SampleSums s;
+    double t = omp_get_wtime();
+    if (!sum_samples_mmap(path, &s)) {
+        printf("Error: could not map %s (needs at least 2 samples)\n", path);
+        return 1;
+    }
+    double res;
+    if (use_simpson) {
+        double second_last = 0.0;
+        if ((s.count - 1) % 2 == 1 && !read_sample(path, s.count - 2, &second_last)) {
+            printf("Error: could not read %s\n", path);
+            return 1;
+        }
+        res = simpson(s, h, second_last);
+    } else {
+        res = trapezoid(s, h);
+    }
+    t = omp_get_wtime() - t;
+
+    double gbytes = s.count * sizeof(double) / 1e9;
+    printf("Samples: %" PRId64 " (%.3f GB), rule: %s\n", s.count, gbytes, use_simpson ? "simpson" : "trapezoid");
+    printf("Result: %.12f\n", res);
+    printf("Execution time: %.6f\n", t);
+    printf("Bandwidth: %.3f GB/s\n", gbytes / t);
+    return 0;
+}
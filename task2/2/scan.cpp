@@ -0,0 +1,105 @@
+#include <cstdlib>
+#include <omp.h>
+#include <time.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <vector>
+#include <cmath>
+
+#define NUM_THREADS 40
+#define PI 3.14159265358979323846
+
+double func(double x) {
+    return exp(-x * x);
+}
+
+/*
+ * integrate_cumulative: F[i] = integral of f over [a, a + (i + 1) * h], midpoint rule,
+ * h = (b - a) / n. F must hold n values; F[n - 1] equals integrate(a, b, n).
+ */
+void integrate_cumulative(double (*func)(double), double a, double b, int64_t n, double *F) {
+    double h = (b - a) / n;
+    double sum = 0.0;
+
+    for (int64_t i = 0; i < n; i++) {
+        sum += func(a + h * (i + 0.5));
+        F[i] = sum * h;
+    }
+}
+
+/*
+ * integrate_cumulative_omp: parallel version of integrate_cumulative.
+ * Pass 1: every thread writes the local running sum of its block into F.
+ * Pass 2: one thread turns the block totals into an exclusive scan (offsets).
+ * Pass 3: every thread adds its offset to its block and scales by h.
+ * The blocks are the same in passes 1 and 3, so each thread touches only
+ * the part of F that is still in its own cache.
+ */
+void integrate_cumulative_omp(double (*func)(double), double a, double b, int64_t n, double *F) {
+    double h = (b - a) / n;
+    std::vector<double> offset(NUM_THREADS + 1, 0.0);
+
+    #pragma omp parallel num_threads(NUM_THREADS)
+    {
+        int nthreads = omp_get_num_threads();
+        int threadid = omp_get_thread_num();
+        int64_t items_per_thread = n / nthreads;
+        int64_t lb = threadid * items_per_thread;
+        int64_t ub = (threadid == nthreads - 1) ? (n - 1) : (lb + items_per_thread - 1);
+        double sumloc = 0.0;
+
+        for (int64_t i = lb; i <= ub; i++) {
+            sumloc += func(a + h * (i + 0.5));
+            F[i] = sumloc;
+        }
+        offset[threadid + 1] = sumloc;
+
+        #pragma omp barrier
+        #pragma omp single
+        {
+            for (int t = 1; t <= nthreads; t++)
+                offset[t] += offset[t - 1];
+        }
+
+        double base = offset[threadid];
+        for (int64_t i = lb; i <= ub; i++)
+            F[i] = (F[i] + base) * h;
+    }
+}
+
+int main(int argc, char **argv) {
+    const double a = -4.0; /* [a, b] */
+    const double b = 4.0;
+    const int64_t nsteps = (argc > 1) ? strtoll(argv[1], NULL, 10) : 40000000; /* n */
+    if (nsteps < 2) { /* F(0) below reads F[nsteps / 2 - 1] */
+        printf("Error: nsteps must be at least 2\n");
+        return 1;
+    }
+
+    std::vector<double> Fserial(nsteps);
+    std::vector<double> Fparallel(nsteps);
+
+    printf("Cumulative integration f(x) on [%.12f, %.12f], nsteps = %" PRId64 "\n", a, b, nsteps);
+
+    double t = omp_get_wtime();
+    integrate_cumulative(func, a, b, nsteps, Fserial.data());
+    double tserial = omp_get_wtime() - t;
+
+    t = omp_get_wtime();
+    integrate_cumulative_omp(func, a, b, nsteps, Fparallel.data());
+    double tparallel = omp_get_wtime() - t;
+
+    double maxdiff = 0.0;
+    for (int64_t i = 0; i < nsteps; i++)
+        maxdiff = fmax(maxdiff, fabs(Fserial[i] - Fparallel[i]));
+
+    /* F(b) is the full integral and F(0) half of it, since f is even */
+    printf("F(b) (parallel): %.12f; error %.12f\n", Fparallel[nsteps - 1], fabs(Fparallel[nsteps - 1] - sqrt(PI)));
+    printf("F(0) (parallel): %.12f; error %.12f\n", Fparallel[nsteps / 2 - 1], fabs(Fparallel[nsteps / 2 - 1] - sqrt(PI) / 2));
+    printf("Max difference (serial vs parallel): %.3e\n", maxdiff);
+
+    printf("Execution time (serial scan): %.6f\n", tserial);
+    printf("Execution time (parallel scan): %.6f\n", tparallel);
+    printf("Speedup: %.2f\n", tserial / tparallel);
+    return 0;
+}
@@ -0,0 +1,250 @@
+#include <cstdlib>
+#include <omp.h>
+#include <time.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <vector>
+#include <cmath>
+
+#define NUM_THREADS 40
+#define COST 100 /* exp calls per evaluation of the expensive integrand */
+#define TABLE_MAGIC 0x42415449 /* "ITAB" */
+#define TABLE_FILE "table.bin"
+#define INITIAL_CELLS 1024
+#define MAX_CELLS (1 << 26)
+
+/* stand-in for a costly integrand: an average of COST gaussians of different widths */
+double expensive(double x) {
+    double sum = 0.0;
+    for (int k = 0; k < COST; k++)
+        sum += exp(-x * x * (1.0 + (double)k / COST));
+    return sum / COST;
+}
+
+double integrate_omp(double (*func)(double), double a, double b, int64_t n) {
+    double h = (b - a) / n;
+    double sum = 0.0;
+
+    #pragma omp parallel num_threads(NUM_THREADS)
+    {
+        int nthreads = omp_get_num_threads();
+        int threadid = omp_get_thread_num();
+        int64_t items_per_thread = n / nthreads;
+        int64_t lb = threadid * items_per_thread;
+        int64_t ub = (threadid == nthreads - 1) ? (n - 1) : (lb + items_per_thread - 1);
+        double sumloc = 0.0;
+
+        for (int64_t i = lb; i <= ub; i++)
+            sumloc += func(a + h * (i + 0.5));
+
+        #pragma omp atomic
+        sum += sumloc;
+    }
+    sum *= h;
+    return sum;
+}
+
+/*
+ * Table: [a, b] split into ncells equal cells, on each cell a cubic in the
+ * local coordinate t in [-1, 1] stored as 4 monomial coefficients.
+ * Uniform cells keep the lookup to one multiply and one truncation.
+ */
+struct Table {
+    char name[32];
+    double a;
+    double b;
+    double tol;
+    int64_t ncells;
+    double inv_width;
+    std::vector<double> coef;
+};
+
+/*
+ * fit_cell: cubic interpolant at the 4 Chebyshev nodes of [lo, hi],
+ * returns the largest deviation from func at t = -1, 0, 1 (the points
+ * farthest from the nodes).
+ */
+double fit_cell(double (*func)(double), double lo, double hi, double *m) {
+    static const double nodes[4] = {0.92387953251128674, 0.38268343236508978,
+                                    -0.38268343236508978, -0.92387953251128674};
+    double mid = 0.5 * (lo + hi);
+    double half = 0.5 * (hi - lo);
+    double c[4] = {0.0, 0.0, 0.0, 0.0};
+
+    for (int j = 0; j < 4; j++) {
+        double t = nodes[j];
+        double f = func(mid + half * t);
+        c[0] += f;
+        c[1] += f * t;
+        c[2] += f * (2.0 * t * t - 1.0);
+        c[3] += f * (4.0 * t * t * t - 3.0 * t);
+    }
+    c[0] *= 0.25;
+    c[1] *= 0.5;
+    c[2] *= 0.5;
+    c[3] *= 0.5;
+
+    /* Chebyshev -> monomial */
+    m[0] = c[0] - c[2];
+    m[1] = c[1] - 3.0 * c[3];
+    m[2] = 2.0 * c[2];
+    m[3] = 4.0 * c[3];
+
+    double err = 0.0;
+    for (int j = -1; j <= 1; j++) {
+        double p = m[0] + j * (m[1] + j * (m[2] + j * m[3]));
+        err = fmax(err, fabs(p - func(mid + half * j)));
+    }
+    return err;
+}
+
+/*
+ * table_build: fill the table in parallel, refining the cell count until the
+ * worst cell error is below tol. Since the error falls like h^4, the next cell
+ * count is guessed from the error ratio instead of just doubling.
+ */
+bool table_build(Table *t, const char *name, double (*func)(double), double a, double b, double tol) {
+    int64_t ncells = INITIAL_CELLS;
+
+    while (true) {
+        std::vector<double> coef(4 * ncells);
+        double width = (b - a) / ncells;
+        double err = 0.0;
+
+        #pragma omp parallel for reduction(max:err) num_threads(NUM_THREADS)
+        for (int64_t i = 0; i < ncells; i++)
+            err = fmax(err, fit_cell(func, a + i * width, a + (i + 1) * width, &coef[4 * i]));
+
+        printf("  table: %" PRId64 " cells, max error %.3e\n", ncells, err);
+        if (err <= tol) {
+            snprintf(t->name, sizeof(t->name), "%s", name);
+            t->a = a;
+            t->b = b;
+            t->tol = tol;
+            t->ncells = ncells;
+            t->inv_width = ncells / (b - a);
+            t->coef.swap(coef);
+            return true;
+        }
+        if (ncells >= MAX_CELLS)
+            return false;
+
+        double factor = ceil(1.2 * pow(err / tol, 0.25));
+        ncells *= (int64_t)fmin(fmax(factor, 2.0), 16.0);
+        if (ncells > MAX_CELLS)
+            ncells = MAX_CELLS;
+    }
+}
+
+inline double table_eval(const Table &t, double x) {
+    double u = (x - t.a) * t.inv_width;
+    int64_t i = (int64_t)u;
+    if (i >= t.ncells)
+        i = t.ncells - 1;
+    double s = 2.0 * (u - i) - 1.0;
+    const double *m = &t.coef[4 * i];
+    return m[0] + s * (m[1] + s * (m[2] + s * m[3]));
+}
+
+/* table_save / table_load: raw binary dump, header followed by the coefficients */
+bool table_save(const Table &t, const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (f == NULL)
+        return false;
+    uint32_t magic = TABLE_MAGIC;
+    bool ok = fwrite(&magic, sizeof(magic), 1, f) == 1 &&
+              fwrite(t.name, sizeof(t.name), 1, f) == 1 &&
+              fwrite(&t.a, sizeof(t.a), 1, f) == 1 &&
+              fwrite(&t.b, sizeof(t.b), 1, f) == 1 &&
+              fwrite(&t.tol, sizeof(t.tol), 1, f) == 1 &&
+              fwrite(&t.ncells, sizeof(t.ncells), 1, f) == 1 &&
+              fwrite(t.coef.data(), sizeof(double), t.coef.size(), f) == t.coef.size();
+    fclose(f);
+    return ok;
+}
+
+bool table_load(Table *t, const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL)
+        return false;
+    uint32_t magic = 0;
+    bool ok = fread(&magic, sizeof(magic), 1, f) == 1 && magic == TABLE_MAGIC &&
+              fread(t->name, sizeof(t->name), 1, f) == 1 &&
+              fread(&t->a, sizeof(t->a), 1, f) == 1 &&
+              fread(&t->b, sizeof(t->b), 1, f) == 1 &&
+              fread(&t->tol, sizeof(t->tol), 1, f) == 1 &&
+              fread(&t->ncells, sizeof(t->ncells), 1, f) == 1 &&
+              t->ncells > 0 && t->ncells <= MAX_CELLS;
+    if (ok) {
+        t->name[sizeof(t->name) - 1] = '\0';
+        t->coef.resize(4 * t->ncells);
+        ok = fread(t->coef.data(), sizeof(double), t->coef.size(), f) == t->coef.size();
+        t->inv_width = t->ncells / (t->b - t->a);
+    }
+    fclose(f);
+    return ok;
+}
+
+/*
+ * table_get: reuse the table in path if it was built for the same integrand,
+ * covers [a, b] and is at least as accurate as tol; otherwise build and save one.
+ */
+bool table_get(Table *t, const char *path, const char *name, double (*func)(double), double a, double b, double tol) {
+    if (table_load(t, path) && strcmp(t->name, name) == 0 && t->a <= a && t->b >= b && t->tol <= tol) {
+        printf("  table: loaded %" PRId64 " cells from %s\n", t->ncells, path);
+        return true;
+    }
+    if (!table_build(t, name, func, a, b, tol))
+        return false;
+    if (!table_save(*t, path))
+        printf("  table: could not write %s\n", path);
+    return true;
+}
+
+double integrate_table(const Table &t, double a, double b, int64_t n) {
+    double h = (b - a) / n;
+    double sum = 0.0;
+
+    #pragma omp parallel for reduction(+:sum) num_threads(NUM_THREADS)
+    for (int64_t i = 0; i < n; i++)
+        sum += table_eval(t, a + h * (i + 0.5));
+
+    return sum * h;
+}
+
+int main(int argc, char **argv) {
+    const double a = -4.0; /* [a, b] */
+    const double b = 4.0;
+    const int64_t nsteps = (argc > 1) ? strtoll(argv[1], NULL, 10) : 40000000; /* n */
+    const double tol = (argc > 2) ? atof(argv[2]) : 1e-12;
+
+    printf("Integration expensive(x) on [%.12f, %.12f], nsteps = %" PRId64 "\n", a, b, nsteps);
+
+    double t = omp_get_wtime();
+    double ref = integrate_omp(expensive, a, b, nsteps);
+    double tdirect = omp_get_wtime() - t;
+    printf("Result (direct): %.12f\n", ref);
+
+    Table table;
+    t = omp_get_wtime();
+    if (!table_get(&table, TABLE_FILE, "expensive", expensive, a, b, tol)) {
+        printf("Error: could not reach tolerance %.1e with %d cells\n", tol, MAX_CELLS);
+        return 1;
+    }
+    double tsetup = omp_get_wtime() - t;
+
+    /* a second job on an overlapping sub-interval is served by the same table */
+    t = omp_get_wtime();
+    double res = integrate_table(table, a, b, nsteps);
+    double sub = integrate_table(table, -1.0, 2.0, nsteps);
+    double ttable = omp_get_wtime() - t;
+    printf("Result (table): %.12f; difference %.3e\n", res, fabs(res - ref));
+    printf("Result (table, [-1, 2]): %.12f\n", sub);
+
+    printf("Execution time (direct): %.6f\n", tdirect);
+    printf("Execution time (table setup): %.6f\n", tsetup);
+    printf("Execution time (table, two integrals): %.6f\n", ttable);
+    printf("Speedup (first integral incl. setup): %.2f\n", tdirect / (tsetup + ttable / 2));
+    return 0;
+}
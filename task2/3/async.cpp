@@ -0,0 +1,254 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <atomic>
+#include <cmath>
+#include <time.h>
+#include <omp.h>
+
+#include "matrix.hpp"
+#include "barrier.hpp"
+
+using namespace std;
+
+const double EPSILON = 1e-5;
+const double TAU = 0.000001;
+const double STOP_MARGIN = 0.5;  // stop when the published residual estimate is below STOP_MARGIN * EPSILON
+const int MAX_SWEEPS = 10000000; // per thread, guards against divergence
+
+double norm(const Vector &v)
+{
+    double sum = 0.0;
+    for (double val : v)
+    {
+        sum += val * val;
+    }
+    return sqrt(sum);
+}
+
+// task32 version
+Vector simpleIterationMethod(const Matrix &A, const Vector &b, int n_threads)
+{
+    int n = A.size();
+    Vector x(n, 0.0);
+    Vector Ax(n);
+    Vector r(n);
+    bool stop = false;
+
+    #pragma omp parallel num_threads(n_threads)
+    {
+        while (true)
+        {
+            #pragma omp single
+            Ax.assign(n, 0.0);
+
+            #pragma omp for nowait
+            for (int i = 0; i < n; ++i)
+            {
+                for (int j = 0; j < n; ++j)
+                {
+                    Ax[i] += A[i][j] * x[j];
+                }
+            }
+
+            #pragma omp single
+            r.assign(n, 0.0);
+
+            #pragma omp for nowait
+            for (int i = 0; i < n; ++i)
+            {
+                r[i] = Ax[i] - b[i];
+            }
+
+            #pragma omp single
+            {
+                if (norm(r) / norm(b) < EPSILON)
+                {
+                    stop = true;
+                }
+            }
+
+            if (stop)
+                break;
+
+            #pragma omp for nowait
+            for (int i = 0; i < n; ++i)
+            {
+                x[i] -= TAU * r[i];
+            }
+        }
+    }
+
+    return x;
+}
+
+struct alignas(CACHE_LINE) PaddedAtomicDouble
+{
+    std::atomic<double> value{0.0};
+};
+
+struct AsyncStats
+{
+    int min_sweeps = 0;
+    int max_sweeps = 0;
+    int restarts = 0;
+    bool converged = false;
+};
+
+// Asynchronous block relaxation. Thread p owns rows [lb, ub) and repeats
+//   r_I = (A x)_I - b_I,  x_I -= TAU * r_I
+// on whatever x values the other threads have published last: at the start of a sweep it
+// copies x into a private view with relaxed atomic loads (one pass over n, so the row
+// products below run on plain doubles and vectorize), and there is no barrier in the loop.
+// After each sweep the thread publishes ||r_I||^2 in its own padded slot and adds up all
+// slots; whoever sees the sum below (STOP_MARGIN * EPSILON)^2 ||b||^2 raises the shared
+// stop flag, which every thread polls once per sweep.
+// The slots may mix residuals of different x versions, so after the team has stopped the
+// true residual is computed once; if it is not small enough the relaxation is resumed.
+Vector asyncBlockRelaxation(const Matrix &A, const Vector &b, int n_threads, AsyncStats *stats)
+{
+    int n = A.size();
+    vector<std::atomic<double>> x(n);
+    for (int i = 0; i < n; ++i)
+    {
+        x[i].store(0.0, std::memory_order_relaxed);
+    }
+    vector<PaddedAtomicDouble> partial(n_threads);
+    vector<int> sweeps(n_threads, 0);
+
+    double b_norm2 = 0.0;
+    for (int i = 0; i < n; ++i)
+    {
+        b_norm2 += b[i] * b[i];
+    }
+    const double threshold = STOP_MARGIN * STOP_MARGIN * EPSILON * EPSILON * b_norm2;
+
+    Vector result(n);
+    while (true)
+    {
+        std::atomic<bool> stop(false);
+        for (int p = 0; p < n_threads; ++p)
+        {
+            partial[p].value.store(b_norm2, std::memory_order_relaxed); // nothing published yet
+        }
+
+        #pragma omp parallel num_threads(n_threads)
+        {
+            int tid = omp_get_thread_num();
+            int nthreads = omp_get_num_threads();
+            int items_per_thread = n / nthreads;
+            int lb = tid * items_per_thread;
+            int ub = (tid == nthreads - 1) ? n : lb + items_per_thread;
+            Vector view(n), r(ub - lb);
+
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                for (int j = 0; j < n; ++j)
+                {
+                    view[j] = x[j].load(std::memory_order_relaxed);
+                }
+
+                double rr = 0.0;
+                for (int i = lb; i < ub; ++i)
+                {
+                    r[i - lb] = rowDot(A, i, view.data()) - b[i];
+                    rr += r[i - lb] * r[i - lb];
+                }
+                for (int i = lb; i < ub; ++i)
+                {
+                    x[i].store(view[i] - TAU * r[i - lb], std::memory_order_relaxed);
+                }
+                partial[tid].value.store(rr, std::memory_order_relaxed);
+
+                double estimate = 0.0;
+                for (int p = 0; p < nthreads; ++p)
+                {
+                    estimate += partial[p].value.load(std::memory_order_relaxed);
+                }
+                if (estimate < threshold || ++sweeps[tid] >= MAX_SWEEPS)
+                {
+                    stop.store(true, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // synchronous check on the final x
+        for (int i = 0; i < n; ++i)
+        {
+            result[i] = x[i].load(std::memory_order_relaxed);
+        }
+        double rr = 0.0;
+        #pragma omp parallel for reduction(+:rr) num_threads(n_threads)
+        for (int i = 0; i < n; ++i)
+        {
+            double ri = rowDot(A, i, result.data()) - b[i];
+            rr += ri * ri;
+        }
+
+        stats->converged = sqrt(rr / b_norm2) < EPSILON;
+        bool capped = false;
+        for (int p = 0; p < n_threads; ++p)
+        {
+            capped = capped || sweeps[p] >= MAX_SWEEPS;
+        }
+        if (stats->converged || capped)
+            break;
+        ++stats->restarts;
+    }
+
+    stats->min_sweeps = stats->max_sweeps = sweeps[0];
+    for (int p = 1; p < n_threads; ++p)
+    {
+        stats->min_sweeps = min(stats->min_sweeps, sweeps[p]);
+        stats->max_sweeps = max(stats->max_sweeps, sweeps[p]);
+    }
+    return result;
+}
+
+int main()
+{
+    int N;
+    cout << "Enter the number of equations (N = 5000 as an example): ";
+    cin >> N;
+
+    if (N <= 0)
+    {
+        cout << "Error: N must be greater than 0" << endl;
+        return 1;
+    }
+
+    Matrix A(N, 1.0);
+    Vector b(N, N + 1);
+    for (int i = 0; i < N; ++i)
+    {
+        A[i][i] = 2.0;
+    }
+
+    std::ofstream out("Out_async.txt");
+    out << "# threads  task32_time  async_time  speedup\n";
+
+    vector<int> thread_counts = {8, 16, 20, 40, 80};
+    for (int n_threads : thread_counts)
+    {
+        if (n_threads > N)
+            break;
+
+        double t = omp_get_wtime();
+        simpleIterationMethod(A, b, n_threads);
+        double t_sync = omp_get_wtime() - t;
+
+        AsyncStats stats;
+        t = omp_get_wtime();
+        asyncBlockRelaxation(A, b, n_threads, &stats);
+        double t_async = omp_get_wtime() - t;
+
+        printf("threads %2d | task32: %.6f sec | async: %.6f sec, sweeps per thread %d..%d, restarts %d, %s | Speedup: %.2f\n",
+               n_threads, t_sync, t_async, stats.min_sweeps, stats.max_sweeps, stats.restarts,
+               stats.converged ? "converged" : "NOT converged", t_sync / t_async);
+        out << n_threads << "\t" << t_sync << "\t" << t_async << "\t" << t_sync / t_async << "\n";
+    }
+
+    out.close();
+    cout << "File has been written" << std::endl;
+    return 0;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <omp.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#define CACHE_LINE 64
+#define SPIN_LIMIT 4096 // spins before a waiting thread starts yielding (matters when oversubscribed)
+
+inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#endif
+}
+
+// One value per cache line, so per-thread slots written in the same phase do not false-share
+struct alignas(CACHE_LINE) PaddedDouble
+{
+    double value = 0.0;
+};
+
+struct alignas(CACHE_LINE) PaddedFlag
+{
+    bool value = false;
+};
+
+// Centralized sense-reversing barrier: the last thread to arrive resets the counter and
+// flips the shared sense, everybody else spins on it. Counter and sense sit on separate
+// cache lines, each thread keeps its own sense on a line of its own.
+// n_threads must be the size of the team that waits on it (omp_get_num_threads(), which
+// can be less than the num_threads requested), otherwise nobody is ever released.
+class SenseBarrier
+{
+public:
+    explicit SenseBarrier(int n_threads) : n(n_threads), count(n_threads), sense(false), local(n_threads) {}
+
+    void wait(int thread_id)
+    {
+        bool my_sense = !local[thread_id].value;
+        local[thread_id].value = my_sense;
+
+        if (count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            count.store(n, std::memory_order_relaxed);
+            sense.store(my_sense, std::memory_order_release);
+        }
+        else
+        {
+            int spins = 0;
+            while (sense.load(std::memory_order_acquire) != my_sense)
+            {
+                if (++spins < SPIN_LIMIT)
+                    cpuRelax();
+                else
+                    std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    int n;
+    alignas(CACHE_LINE) std::atomic<int> count;
+    alignas(CACHE_LINE) std::atomic<bool> sense;
+    std::vector<PaddedFlag> local;
+};
+
+// Same interface on top of the OpenMP barrier, for comparison
+class OmpBarrier
+{
+public:
+    explicit OmpBarrier(int) {}
+
+    void wait(int)
+    {
+        #pragma omp barrier
+    }
+};
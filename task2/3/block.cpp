@@ -0,0 +1,131 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <time.h>
+#include <omp.h>
+
+#include "matrix.hpp"
+#include "iteration.hpp"
+#include "block.hpp"
+
+#define N_THREADS 8
+#define N_RHS 16
+
+using namespace std;
+
+const double EPSILON = 1e-5;
+const double TAU = 0.000001;
+
+double relativeResidual(const Matrix &A, const Vector &b, const Vector &x)
+{
+    double rr = 0.0, bb = 0.0;
+    for (int i = 0; i < A.size(); ++i)
+    {
+        double r = rowDot(A, i, x.data()) - b[i];
+        rr += r * r;
+        bb += b[i] * b[i];
+    }
+    return sqrt(rr / bb);
+}
+
+// Regression run: the task system at N = 40 with N_RHS right-hand sides takes about
+// 280000 block iterations. It used to overflow the stack long before that (a per-iteration
+// stack allocation for the reduction of the k residual norms).
+void runManyIterations()
+{
+    const int n = 40;
+    Matrix A(n, 1.0);
+    for (int i = 0; i < n; ++i)
+    {
+        A[i][i] = 2.0;
+    }
+    vector<Vector> B(N_RHS);
+    for (int c = 0; c < N_RHS; ++c)
+    {
+        B[c].assign(n, (n + 1) * (1.0 + 0.1 * c));
+    }
+
+    vector<int> it;
+    double t = omp_get_wtime();
+    vector<Vector> X = blockSimpleIterationMethod(A, B, TAU, EPSILON, N_THREADS, &it);
+    t = omp_get_wtime() - t;
+
+    double worst = 0.0;
+    for (int c = 0; c < N_RHS; ++c)
+    {
+        worst = max(worst, relativeResidual(A, B[c], X[c]));
+    }
+    printf("Many iterations (N %d, %d right-hand sides): %d iterations, %.6f sec, worst residual %.2e\n", n, N_RHS,
+           *max_element(it.begin(), it.end()), t, worst);
+}
+
+int main()
+{
+    int N;
+    cout << "Enter the number of equations (N = 5000 as an example): ";
+    cin >> N;
+
+    if (N <= 0)
+    {
+        cout << "Error: N must be greater than 0" << endl;
+        return 1;
+    }
+
+    Matrix A(N, 1.0);
+    for (int i = 0; i < N; ++i)
+    {
+        A[i][i] = 2.0;
+    }
+
+    // b_c = (N + 1) * (1 + p_c), p_c orthogonal to the constant vector with ||p_c|| / ||1||
+    // growing with c up to EPSILON / 2. The simple iteration with the tiny TAU does not
+    // reduce p_c in any useful time, so each b_c needs a different number of iterations
+    // to get below EPSILON and the columns converge (and are deflated) one after another.
+    vector<Vector> B(N_RHS, Vector(N));
+    for (int c = 0; c < N_RHS; ++c)
+    {
+        double amplitude = 0.5 * EPSILON * c / N_RHS;
+        for (int i = 0; i < N; ++i)
+        {
+            double sign = (i % 2 == 0) ? 1.0 : -1.0;
+            if (N % 2 == 1 && i == N - 1)
+                sign = 0.0;
+            B[c][i] = (N + 1) * (1.0 + amplitude * sign);
+        }
+    }
+
+    double t = omp_get_wtime();
+    vector<Vector> X_single(N_RHS);
+    vector<int> it_single(N_RHS);
+    for (int c = 0; c < N_RHS; ++c)
+    {
+        X_single[c] = simpleIterationMethodFused(A, B[c], TAU, EPSILON, N_THREADS, &it_single[c]);
+    }
+    double t_single = omp_get_wtime() - t;
+
+    vector<int> it_block;
+    t = omp_get_wtime();
+    vector<Vector> X_block = blockSimpleIterationMethod(A, B, TAU, EPSILON, N_THREADS, &it_block);
+    double t_block = omp_get_wtime() - t;
+
+    double worst_single = 0.0, worst_block = 0.0;
+    for (int c = 0; c < N_RHS; ++c)
+    {
+        worst_single = max(worst_single, relativeResidual(A, B[c], X_single[c]));
+        worst_block = max(worst_block, relativeResidual(A, B[c], X_block[c]));
+        printf("  rhs %2d: %d iterations (one at a time: %d)\n", c, it_block[c], it_single[c]);
+    }
+    printf("%d right-hand sides | One at a time: %.6f sec, worst residual %.2e | Block: %.6f sec, worst residual %.2e | Speedup: %.2f\n",
+           N_RHS, t_single, worst_single, t_block, worst_block, t_single / t_block);
+
+    runManyIterations();
+
+    std::ofstream out("Out_block.txt");
+    out << "# rhs  single_time  block_time  speedup\n";
+    out << N_RHS << "\t" << t_single << "\t" << t_block << "\t" << t_single / t_block << "\n";
+    out.close();
+    cout << "File has been written" << std::endl;
+    return 0;
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include <omp.h>
+
+#include "matrix.hpp"
+
+#define RHS_TILE 8 // right-hand sides per pass over a row of A (accumulators kept in registers)
+
+// Simple iteration x_c <- x_c - tau * (A x_c - b_c) for k right-hand sides at once.
+// B and X are stored row-interleaved (element (i, c) at [i * k + c]), so one pass over
+// row i of A updates row i of every solution: each A[i][j] is loaded once and multiplied
+// with the k contiguous values X[j][0 .. k), and A is streamed once per iteration instead
+// of once per right-hand side. The columns are processed RHS_TILE at a time, re-reading
+// the row from cache for every further tile.
+// Every column has its own ||r_c|| / ||b_c|| < epsilon test. A converged column is copied
+// out and the last active column is moved into its slot, so the active columns always
+// are the first `active` ones and the inner loop just gets shorter.
+// The k residual norms are summed in per-thread rows of partial (whole cache lines per
+// row) and added up in the single, not by an array reduction: a reduction over a section
+// of run-time length k makes GCC allocate the private copies on the stack in every
+// iteration, and a long solve overflows it.
+// No preconditioner: Preconditioner::apply works on one contiguous vector, not on the
+// interleaved columns.
+inline std::vector<Vector> blockSimpleIterationMethod(const Matrix &A, const std::vector<Vector> &B, double tau,
+                                                      double epsilon, int n_threads,
+                                                      std::vector<int> *iterations = nullptr)
+{
+    int n = A.size();
+    int k = B.size();
+    Vector X((size_t)n * k, 0.0), X_next((size_t)n * k), Bi((size_t)n * k);
+    Vector b_norm2(k, 0.0), r_norm2(k, 0.0);
+    const int stride = (k + 7) / 8 * 8; // doubles per row of partial
+    Vector partial((size_t)n_threads * stride);
+    std::vector<int> column(k); // column[slot] = index of the right-hand side stored in slot
+    std::vector<Vector> result(k, Vector(n));
+    std::vector<int> iter_count(k, 0);
+    int active = k;
+    int iter = 0;
+
+    for (int c = 0; c < k; ++c)
+    {
+        column[c] = c;
+    }
+
+    #pragma omp parallel num_threads(n_threads)
+    {
+        #pragma omp for schedule(static)
+        for (int i = 0; i < n; ++i)
+        {
+            for (int c = 0; c < k; ++c)
+            {
+                Bi[(size_t)i * k + c] = B[c][i];
+            }
+        }
+
+        #pragma omp single
+        for (int c = 0; c < k; ++c)
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                b_norm2[c] += B[c][i] * B[c][i];
+            }
+        }
+
+        const int team = omp_get_num_threads();
+        double *rn = partial.data() + (size_t)omp_get_thread_num() * stride; // this thread's row
+
+        while (active > 0)
+        {
+            const int m = active;
+            const double *xp = X.data();
+            double *xn = X_next.data();
+            for (int c = 0; c < m; ++c)
+            {
+                rn[c] = 0.0;
+            }
+
+            #pragma omp for schedule(static)
+            for (int i = 0; i < n; ++i)
+            {
+                const double *row = A[i];
+                const size_t ik = (size_t)i * k;
+                for (int c0 = 0; c0 < m; c0 += RHS_TILE)
+                {
+                    double acc[RHS_TILE] = {0.0};
+                    if (c0 + RHS_TILE <= m)
+                    {
+                        // full tile: fixed trip count, acc stays in registers
+                        for (int j = 0; j < n; ++j)
+                        {
+                            const double a = row[j];
+                            const double *xj = xp + (size_t)j * k + c0;
+                            for (int c = 0; c < RHS_TILE; ++c)
+                            {
+                                acc[c] += a * xj[c];
+                            }
+                        }
+                    }
+                    else
+                    {
+                        for (int j = 0; j < n; ++j)
+                        {
+                            const double a = row[j];
+                            const double *xj = xp + (size_t)j * k + c0;
+                            for (int c = 0; c < m - c0; ++c)
+                            {
+                                acc[c] += a * xj[c];
+                            }
+                        }
+                    }
+                    for (int c = c0; c < std::min(m, c0 + RHS_TILE); ++c)
+                    {
+                        double r = acc[c - c0] - Bi[ik + c];
+                        rn[c] += r * r;
+                        xn[ik + c] = xp[ik + c] - tau * r;
+                    }
+                }
+            }
+
+            // the residual was measured for X: converged columns are taken from X,
+            // the others continue from X_next
+            #pragma omp single
+            {
+                for (int c = 0; c < active; ++c)
+                {
+                    r_norm2[c] = 0.0;
+                    for (int p = 0; p < team; ++p)
+                    {
+                        r_norm2[c] += partial[(size_t)p * stride + c];
+                    }
+                }
+
+                for (int c = 0; c < active;)
+                {
+                    if (sqrt(r_norm2[c] / b_norm2[c]) >= epsilon)
+                    {
+                        ++c;
+                        continue;
+                    }
+
+                    for (int i = 0; i < n; ++i)
+                    {
+                        result[column[c]][i] = X[(size_t)i * k + c];
+                    }
+                    iter_count[column[c]] = iter;
+
+                    int last = --active;
+                    if (c != last)
+                    {
+                        for (int i = 0; i < n; ++i)
+                        {
+                            size_t ik = (size_t)i * k;
+                            X[ik + c] = X[ik + last];
+                            X_next[ik + c] = X_next[ik + last];
+                            Bi[ik + c] = Bi[ik + last];
+                        }
+                        column[c] = column[last];
+                        b_norm2[c] = b_norm2[last];
+                        r_norm2[c] = r_norm2[last];
+                    }
+                }
+                X.swap(X_next);
+                ++iter;
+            }
+        }
+    }
+
+    if (iterations != nullptr)
+    {
+        *iterations = iter_count;
+    }
+    return result;
+}
@@ -0,0 +1,74 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <time.h>
+#include <omp.h>
+
+#include "matrix.hpp"
+#include "iteration.hpp"
+#include "cg.hpp"
+
+#define N_THREADS 8
+
+using namespace std;
+
+const double EPSILON = 1e-5;
+const double TAU = 0.000001;
+
+double relativeResidual(const Matrix &A, const Vector &b, const Vector &x)
+{
+    double rr = 0.0, bb = 0.0;
+    for (int i = 0; i < A.size(); ++i)
+    {
+        double r = rowDot(A, i, x.data()) - b[i];
+        rr += r * r;
+        bb += b[i] * b[i];
+    }
+    return sqrt(rr / bb);
+}
+
+int main()
+{
+    int max_N;
+    cout << "Enter the largest number of equations (N = 5000 as an example): ";
+    cin >> max_N;
+
+    if (max_N <= 0)
+    {
+        cout << "Error: N must be greater than 0" << endl;
+        return 1;
+    }
+
+    std::ofstream out("Out_cg.txt");
+    out << "# N  simple_time  simple_iterations  cg_time  cg_iterations  speedup\n";
+
+    for (int N = 500; N <= max_N; N *= 2)
+    {
+        Matrix A(N, 1.0);
+        Vector b(N, N + 1);
+        for (int i = 0; i < N; ++i)
+        {
+            A[i][i] = 2.0;
+        }
+
+        int iter_simple, iter_cg;
+
+        double t = omp_get_wtime();
+        Vector x_simple = simpleIterationMethodFused(A, b, TAU, EPSILON, N_THREADS, &iter_simple);
+        double t_simple = omp_get_wtime() - t;
+
+        t = omp_get_wtime();
+        Vector x_cg = conjugateGradientMethod(A, b, EPSILON, N_THREADS, &iter_cg);
+        double t_cg = omp_get_wtime() - t;
+
+        printf("N: %d | Simple iteration: %d it, %.6f sec, residual %.2e | CG: %d it, %.6f sec, residual %.2e | Speedup: %.1f\n",
+               N, iter_simple, t_simple, relativeResidual(A, b, x_simple),
+               iter_cg, t_cg, relativeResidual(A, b, x_cg), t_simple / t_cg);
+        out << N << "\t" << t_simple << "\t" << iter_simple << "\t" << t_cg << "\t" << iter_cg << "\t" << t_simple / t_cg << "\n";
+    }
+
+    out.close();
+    cout << "File has been written" << std::endl;
+    return 0;
+}
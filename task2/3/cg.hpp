@@ -0,0 +1,236 @@
+#pragma once
+
+#include <cmath>
+#include <omp.h>
+
+#include "matrix.hpp"
+#include "preconditioner.hpp"
+
+// Conjugate gradient method for a symmetric positive definite A.
+// Same stopping rule as simpleIterationMethod: ||A x - b|| / ||b|| < epsilon,
+// with the recursively updated residual r standing in for A x - b.
+// One parallel region for the whole solve; per iteration there are three passes:
+// Ap and (p, Ap) together, then x, r and (r, r) together, then the new p.
+// With a preconditioner M, z = M^{-1} r and (r, z) are computed in between;
+// without one z is r itself and no extra pass is made.
+// The product with A runs over rowBegin parts, one per thread.
+// A (and M) must be SPD. (p, A p) <= 0 proves that A is not, and then the method stops
+// at once with *breakdown set instead of iterating on meaningless steps; x is the last
+// iterate.
+template <typename Op>
+Vector conjugateGradientMethod(const Op &A, const Vector &b, double epsilon, int n_threads, int *iterations = nullptr,
+                               const Preconditioner *M = nullptr, bool *breakdown = nullptr)
+{
+    int n = A.size();
+    Vector x(n), r(n), p(n), Ap(n);
+    Vector z_storage(M != nullptr ? n : 0);
+    double *z = (M != nullptr) ? z_storage.data() : r.data();
+    double rr = 0.0;
+    double rr_new = 0.0;
+    double rz = 0.0;
+    double rz_new = 0.0;
+    double pAp = 0.0;
+    int iter = 0;
+    bool indefinite = false;
+
+    #pragma omp parallel num_threads(n_threads)
+    {
+        #pragma omp for reduction(+:rr) schedule(static)
+        for (int i = 0; i < n; ++i)
+        {
+            x[i] = 0.0;
+            r[i] = b[i];
+            rr += b[i] * b[i];
+        }
+        const double bb = rr;
+
+        if (M != nullptr)
+        {
+            M->apply(r.data(), z);
+        }
+
+        #pragma omp for reduction(+:rz) schedule(static)
+        for (int i = 0; i < n; ++i)
+        {
+            p[i] = z[i];
+            rz += r[i] * z[i];
+        }
+
+        while (sqrt(rr / bb) >= epsilon)
+        {
+            const int parts = omp_get_num_threads();
+            #pragma omp for reduction(+:pAp) schedule(static, 1)
+            for (int part = 0; part < parts; ++part)
+            {
+                const int end = rowBegin(A, part + 1, parts);
+                for (int i = rowBegin(A, part, parts); i < end; ++i)
+                {
+                    Ap[i] = rowDot(A, i, p.data());
+                    pAp += p[i] * Ap[i];
+                }
+            }
+            if (!(pAp > 0.0))
+            {
+                // every thread sees the same pAp, so they all leave here
+                #pragma omp atomic write
+                indefinite = true;
+                break;
+            }
+            const double alpha = rz / pAp;
+
+            #pragma omp for reduction(+:rr_new) schedule(static)
+            for (int i = 0; i < n; ++i)
+            {
+                x[i] += alpha * p[i];
+                r[i] -= alpha * Ap[i];
+                rr_new += r[i] * r[i];
+            }
+
+            double beta;
+            if (M != nullptr)
+            {
+                M->apply(r.data(), z);
+
+                #pragma omp for reduction(+:rz_new) schedule(static)
+                for (int i = 0; i < n; ++i)
+                {
+                    rz_new += r[i] * z[i];
+                }
+                beta = rz_new / rz;
+            }
+            else
+            {
+                beta = rr_new / rz;
+            }
+
+            #pragma omp for schedule(static)
+            for (int i = 0; i < n; ++i)
+            {
+                p[i] = z[i] + beta * p[i];
+            }
+
+            // every thread has read rr, rz, rr_new, rz_new and pAp by now (barrier after the loop above)
+            #pragma omp single
+            {
+                rr = rr_new;
+                rz = (M != nullptr) ? rz_new : rr_new;
+                rr_new = 0.0;
+                rz_new = 0.0;
+                pAp = 0.0;
+                ++iter;
+            }
+        }
+    }
+
+    if (iterations != nullptr)
+    {
+        *iterations = iter;
+    }
+    if (breakdown != nullptr)
+    {
+        *breakdown = indefinite;
+    }
+    return x;
+}
+
+// Pipelined CG (Ghysels and Vanroose), unpreconditioned. Besides r it carries w = A r and
+// the recurrences z = A s, s = A p, so both dot products of an iteration, (r, r) and
+// (w, r), are formed from vectors that are already known when the iteration starts.
+// They are then computed in the same pass as the one matrix-vector product q = A w,
+// and their reduction completes at the barrier that ends that pass anyway. The second
+// pass updates z, s, p, x, r and w element by element.
+// So an iteration has one reduction and two barriers, against two reductions and four
+// barriers (three loops and the single) in conjugateGradientMethod. No single either:
+// every thread derives alpha and beta itself, and the reduction targets alternate by
+// iteration parity, so thread 0 can clear the pair of the next iteration while the
+// others are still reading the current one.
+template <typename Op>
+Vector pipelinedConjugateGradientMethod(const Op &A, const Vector &b, double epsilon, int n_threads,
+                                        int *iterations = nullptr)
+{
+    int n = A.size();
+    Vector x(n), r(n), w(n), q(n), z(n), s(n), p(n);
+    double bb = 0.0;
+    double acc[4] = {0.0, 0.0, 0.0, 0.0}; // (r, r) and (w, r) for even and odd iterations
+    int iter = 0;
+
+    #pragma omp parallel num_threads(n_threads)
+    {
+        const int tid = omp_get_thread_num();
+        const int parts = omp_get_num_threads();
+
+        #pragma omp for reduction(+:bb) schedule(static)
+        for (int i = 0; i < n; ++i)
+        {
+            x[i] = 0.0;
+            r[i] = b[i];
+            z[i] = s[i] = p[i] = 0.0;
+            bb += b[i] * b[i];
+        }
+
+        #pragma omp for schedule(static, 1)
+        for (int part = 0; part < parts; ++part)
+        {
+            const int end = rowBegin(A, part + 1, parts);
+            for (int i = rowBegin(A, part, parts); i < end; ++i)
+            {
+                w[i] = rowDot(A, i, r.data());
+            }
+        }
+
+        double gamma_old = 1.0, alpha_old = 1.0;
+        for (int k = 0;; ++k)
+        {
+            // this iteration's pair is acc[c], acc[c + 1]; the reduction names a section of
+            // the shared acc itself (a list item must be shared in the enclosing region)
+            const int c = 2 * (k & 1);
+
+            #pragma omp for reduction(+:acc[c:2]) schedule(static, 1)
+            for (int part = 0; part < parts; ++part)
+            {
+                const int end = rowBegin(A, part + 1, parts);
+                for (int i = rowBegin(A, part, parts); i < end; ++i)
+                {
+                    q[i] = rowDot(A, i, w.data());
+                    acc[c] += r[i] * r[i];
+                    acc[c + 1] += w[i] * r[i];
+                }
+            }
+            const double gamma = acc[c];
+            const double delta = acc[c + 1];
+            if (tid == 0)
+            {
+                acc[2 - c] = acc[3 - c] = 0.0;
+            }
+
+            if (sqrt(gamma / bb) < epsilon)
+            {
+                if (tid == 0)
+                    iter = k;
+                break;
+            }
+
+            const double beta = (k > 0) ? gamma / gamma_old : 0.0;
+            const double alpha = (k > 0) ? gamma / (delta - beta * gamma / alpha_old) : gamma / delta;
+
+            #pragma omp for schedule(static)
+            for (int i = 0; i < n; ++i)
+            {
+                z[i] = q[i] + beta * z[i];
+                s[i] = w[i] + beta * s[i];
+                p[i] = r[i] + beta * p[i];
+                x[i] += alpha * p[i];
+                r[i] -= alpha * s[i];
+                w[i] -= alpha * z[i];
+            }
+            gamma_old = gamma;
+            alpha_old = alpha;
+        }
+    }
+
+    if (iterations != nullptr)
+    {
+        *iterations = iter;
+    }
+    return x;
+}
@@ -0,0 +1,81 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <time.h>
+#include <omp.h>
+
+#include "matrix.hpp"
+#include "iteration.hpp"
+#include "chebyshev.hpp"
+
+#define N_THREADS 8
+
+using namespace std;
+
+const double EPSILON = 1e-5;
+const double TAU = 0.000001;
+
+double relativeResidual(const Matrix &A, const Vector &b, const Vector &x)
+{
+    double rr = 0.0, bb = 0.0;
+    for (int i = 0; i < A.size(); ++i)
+    {
+        double r = rowDot(A, i, x.data()) - b[i];
+        rr += r * r;
+        bb += b[i] * b[i];
+    }
+    return sqrt(rr / bb);
+}
+
+int main()
+{
+    int max_N;
+    cout << "Enter the largest number of equations (N = 5000 as an example): ";
+    cin >> max_N;
+
+    if (max_N <= 0)
+    {
+        cout << "Error: N must be greater than 0" << endl;
+        return 1;
+    }
+
+    std::ofstream out("Out_chebyshev.txt");
+    out << "# N  simple_time  simple_iterations  estimate_time  chebyshev_time  chebyshev_iterations  speedup\n";
+
+    for (int N = 500; N <= max_N; N *= 2)
+    {
+        Matrix A(N, 1.0);
+        Vector b(N, N + 1);
+        for (int i = 0; i < N; ++i)
+        {
+            A[i][i] = 2.0;
+        }
+
+        int iter_simple, iter_cheb;
+
+        double t = omp_get_wtime();
+        Vector x_simple = simpleIterationMethodFused(A, b, TAU, EPSILON, N_THREADS, &iter_simple);
+        double t_simple = omp_get_wtime() - t;
+
+        t = omp_get_wtime();
+        double lambda_min, lambda_max;
+        estimateSpectrum(A, N_THREADS, &lambda_min, &lambda_max);
+        double t_estimate = omp_get_wtime() - t;
+
+        t = omp_get_wtime();
+        Vector x_cheb = chebyshevIterationMethod(A, b, lambda_min, lambda_max, EPSILON, N_THREADS, &iter_cheb);
+        double t_cheb = omp_get_wtime() - t;
+
+        printf("N: %d | Spectrum estimate [%.4f, %.4f] in %.6f sec\n", N, lambda_min, lambda_max, t_estimate);
+        printf("  Fixed TAU: %d it, %.6f sec, residual %.2e | Chebyshev: %d it, %.6f sec, residual %.2e | Speedup (incl. estimate): %.1f\n",
+               iter_simple, t_simple, relativeResidual(A, b, x_simple),
+               iter_cheb, t_cheb, relativeResidual(A, b, x_cheb), t_simple / (t_estimate + t_cheb));
+        out << N << "\t" << t_simple << "\t" << iter_simple << "\t" << t_estimate << "\t" << t_cheb << "\t" << iter_cheb
+            << "\t" << t_simple / (t_estimate + t_cheb) << "\n";
+    }
+
+    out.close();
+    cout << "File has been written" << std::endl;
+    return 0;
+}
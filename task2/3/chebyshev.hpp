@@ -0,0 +1,227 @@
+#pragma once
+
+#include <cmath>
+#include <omp.h>
+
+#include "matrix.hpp"
+#include "preconditioner.hpp"
+
+#define POWER_ITERATIONS 30
+#define SPECTRUM_MARGIN 0.05 // widen the estimated [lambda_min, lambda_max] by 5% on both sides
+#define CHECK_INTERVAL 10    // residual norm is computed only every CHECK_INTERVAL iterations
+
+// Dominant eigenvalue of (M^{-1} A - shift * I) by the power method, Rayleigh quotient as
+// the estimate. Without M the product, the shift and the sums are one pass; with M the
+// product goes to Av first and M^{-1} is applied in between.
+template <typename Op>
+double powerMethod(const Op &A, double shift, int steps, int n_threads, const Preconditioner *M = nullptr)
+{
+    int n = A.size();
+    Vector v(n), y(n);
+    Vector Av(M != nullptr ? n : 0);
+    double vy = 0.0, vv = 0.0, yy = 0.0;
+    double lambda = 0.0;
+
+    #pragma omp parallel num_threads(n_threads)
+    {
+        // not a constant vector: for the task matrix that would be an eigenvector already
+        #pragma omp for schedule(static)
+        for (int i = 0; i < n; ++i)
+        {
+            v[i] = 1.0 + 0.5 * ((i * 7919) % 1000) / 1000.0;
+        }
+
+        for (int k = 0; k < steps; ++k)
+        {
+            const int parts = omp_get_num_threads();
+            if (M == nullptr)
+            {
+                #pragma omp for reduction(+:vy, vv, yy) schedule(static, 1)
+                for (int part = 0; part < parts; ++part)
+                {
+                    const int end = rowBegin(A, part + 1, parts);
+                    for (int i = rowBegin(A, part, parts); i < end; ++i)
+                    {
+                        y[i] = rowDot(A, i, v.data()) - shift * v[i];
+                        vy += v[i] * y[i];
+                        vv += v[i] * v[i];
+                        yy += y[i] * y[i];
+                    }
+                }
+            }
+            else
+            {
+                #pragma omp for schedule(static, 1)
+                for (int part = 0; part < parts; ++part)
+                {
+                    const int end = rowBegin(A, part + 1, parts);
+                    for (int i = rowBegin(A, part, parts); i < end; ++i)
+                    {
+                        Av[i] = rowDot(A, i, v.data());
+                    }
+                }
+
+                M->apply(Av.data(), y.data());
+
+                #pragma omp for reduction(+:vy, vv, yy) schedule(static)
+                for (int i = 0; i < n; ++i)
+                {
+                    y[i] -= shift * v[i];
+                    vy += v[i] * y[i];
+                    vv += v[i] * v[i];
+                    yy += y[i] * y[i];
+                }
+            }
+            const double scale = 1.0 / sqrt(yy);
+
+            #pragma omp for schedule(static)
+            for (int i = 0; i < n; ++i)
+            {
+                v[i] = y[i] * scale;
+            }
+
+            #pragma omp single
+            {
+                lambda = vy / vv;
+                vy = vv = yy = 0.0;
+            }
+        }
+    }
+    return lambda;
+}
+
+// Bounds of the spectrum of an SPD operator: lambda_max from A itself,
+// lambda_min from A - lambda_max * I, whose dominant eigenvalue is lambda_min - lambda_max.
+// Both are widened by SPECTRUM_MARGIN since the power method approaches them from inside.
+// With an SPD preconditioner M the bounds are those of M^{-1} A, as the preconditioned
+// chebyshevIterationMethod needs them.
+template <typename Op>
+void estimateSpectrum(const Op &A, int n_threads, double *lambda_min, double *lambda_max,
+                      const Preconditioner *M = nullptr)
+{
+    double hi = powerMethod(A, 0.0, POWER_ITERATIONS, n_threads, M);
+    double lo = hi + powerMethod(A, hi, POWER_ITERATIONS, n_threads, M);
+    *lambda_max = hi * (1.0 + SPECTRUM_MARGIN);
+    *lambda_min = (lo > 0.0) ? lo * (1.0 - SPECTRUM_MARGIN) : hi * 1e-6;
+}
+
+// Chebyshev semi-iterative method on [lambda_min, lambda_max]. The step coefficients
+// come from the Chebyshev recurrence and need no dot products, so an iteration is
+// one pass: d is read from one buffer, the next d written to the other, and the
+// buffers alternate by iteration parity. The only barrier is the one after that pass.
+// ||r|| / ||b|| < epsilon is tested every CHECK_INTERVAL iterations.
+// With a preconditioner M the recurrence runs on M^{-1} A (the bounds must be those of
+// M^{-1} A, see estimateSpectrum) and the new d is built from z = M^{-1} r, in a second
+// pass after M->apply.
+template <typename Op>
+Vector chebyshevIterationMethod(const Op &A, const Vector &b, double lambda_min, double lambda_max,
+                                double epsilon, int n_threads, int *iterations = nullptr,
+                                const Preconditioner *M = nullptr)
+{
+    int n = A.size();
+    const double theta = 0.5 * (lambda_max + lambda_min);
+    const double delta = 0.5 * (lambda_max - lambda_min);
+    const double sigma = theta / delta;
+
+    Vector x(n, 0.0), r(n);
+    Vector z(M != nullptr ? n : 0);
+    Vector d[2] = {Vector(n), Vector(n)};
+    double bb = 0.0, rr = 0.0;
+    bool stop = false;
+    int iter = 0;
+
+    #pragma omp parallel num_threads(n_threads)
+    {
+        #pragma omp for reduction(+:bb) schedule(static)
+        for (int i = 0; i < n; ++i)
+        {
+            r[i] = b[i];
+            d[0][i] = b[i] / theta;
+            bb += b[i] * b[i];
+        }
+
+        if (M != nullptr)
+        {
+            M->apply(r.data(), z.data());
+
+            #pragma omp for schedule(static)
+            for (int i = 0; i < n; ++i)
+            {
+                d[0][i] = z[i] / theta;
+            }
+        }
+
+        double rho = 1.0 / sigma;
+        for (int k = 0; !stop; ++k)
+        {
+            const double rho_next = 1.0 / (2.0 * sigma - rho);
+            const double c_d = rho_next * rho;
+            const double c_r = 2.0 * rho_next / delta;
+            const double *dk = d[k & 1].data();
+            double *dn = d[(k + 1) & 1].data();
+            const bool check = (k + 1) % CHECK_INTERVAL == 0;
+            const bool fused = M == nullptr;
+            const int parts = omp_get_num_threads();
+
+            if (check)
+            {
+                #pragma omp for reduction(+:rr) schedule(static, 1)
+                for (int part = 0; part < parts; ++part)
+                {
+                    const int end = rowBegin(A, part + 1, parts);
+                    for (int i = rowBegin(A, part, parts); i < end; ++i)
+                    {
+                        x[i] += dk[i];
+                        r[i] -= rowDot(A, i, dk);
+                        if (fused)
+                            dn[i] = c_d * dk[i] + c_r * r[i];
+                        rr += r[i] * r[i];
+                    }
+                }
+            }
+            else
+            {
+                #pragma omp for schedule(static, 1)
+                for (int part = 0; part < parts; ++part)
+                {
+                    const int end = rowBegin(A, part + 1, parts);
+                    for (int i = rowBegin(A, part, parts); i < end; ++i)
+                    {
+                        x[i] += dk[i];
+                        r[i] -= rowDot(A, i, dk);
+                        if (fused)
+                            dn[i] = c_d * dk[i] + c_r * r[i];
+                    }
+                }
+            }
+
+            if (!fused)
+            {
+                M->apply(r.data(), z.data());
+
+                #pragma omp for schedule(static)
+                for (int i = 0; i < n; ++i)
+                {
+                    dn[i] = c_d * dk[i] + c_r * z[i];
+                }
+            }
+
+            if (check)
+            {
+                #pragma omp single
+                {
+                    iter = k + 1;
+                    stop = sqrt(rr / bb) < epsilon;
+                    rr = 0.0;
+                }
+            }
+            rho = rho_next;
+        }
+    }
+
+    if (iterations != nullptr)
+    {
+        *iterations = iter;
+    }
+    return x;
+}
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <omp.h>
+
+#include "matrix.hpp"
+
+// Square sparse matrix in compressed sparse row form: the nonzeros of row i are
+// col[row_ptr[i] .. row_ptr[i + 1]) and val[...], sorted by column.
+// Accepted by the solvers templated on the operator: simpleIterationMethodFused,
+// conjugateGradientMethod (and the pipelined one), powerMethod / estimateSpectrum,
+// chebyshevIterationMethod, gmresMethod and biCGStabMethod. The block and mixed
+// precision solvers, the preconditioners and the direct methods take a dense Matrix only.
+class CsrMatrix
+{
+public:
+    int size() const { return n; }
+    size_t nonzeros() const { return row_ptr.empty() ? 0 : row_ptr[n]; }
+
+    int n = 0;
+    std::vector<size_t> row_ptr;
+    std::vector<int> col;
+    Vector val;
+};
+
+inline double rowDot(const CsrMatrix &A, int i, const double *x)
+{
+    double sum = 0.0;
+    for (size_t k = A.row_ptr[i]; k < A.row_ptr[i + 1]; ++k)
+    {
+        sum += A.val[k] * x[A.col[k]];
+    }
+    return sum;
+}
+
+// Rows split by nonzeros: part p starts at the first row whose row_ptr reaches
+// p / parts of all nonzeros, so every part does the same amount of SpMV work.
+// A binary search, so callers compute the end of a part once, not in the row loop test.
+inline int rowBegin(const CsrMatrix &A, int part, int parts)
+{
+    if (part >= parts)
+        return A.n;
+    size_t target = A.nonzeros() * part / parts;
+    return std::lower_bound(A.row_ptr.begin(), A.row_ptr.end() - 1, target) - A.row_ptr.begin();
+}
+
+// ---- Matrix Market reader ----
+
+struct MatrixMarketEntry
+{
+    int row;
+    int col;
+    double val;
+};
+
+inline const char *skipSpaces(const char *p, const char *end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+        ++p;
+    return p;
+}
+
+// Blank and comment lines carry no entry
+inline bool isEntryLine(const char *p, const char *end)
+{
+    p = skipSpaces(p, end);
+    return p != end && *p != '\n' && *p != '%';
+}
+
+// Entry of an entry line "i j [v]", 1-based in the file, 0-based in e. False if a field
+// is missing or not a number, anything follows the last field, or an index is not in 1..n.
+inline bool parseEntry(const char *p, const char *end, bool pattern, int n, MatrixMarketEntry &e)
+{
+    auto r = std::from_chars(skipSpaces(p, end), end, e.row);
+    if (r.ec != std::errc())
+        return false;
+    r = std::from_chars(skipSpaces(r.ptr, end), end, e.col);
+    if (r.ec != std::errc())
+        return false;
+    e.val = 1.0;
+    if (!pattern)
+    {
+        r = std::from_chars(skipSpaces(r.ptr, end), end, e.val);
+        if (r.ec != std::errc())
+            return false;
+    }
+    if (skipSpaces(r.ptr, end) != end || e.row < 1 || e.row > n || e.col < 1 || e.col > n)
+        return false;
+    --e.row;
+    --e.col;
+    return true;
+}
+
+// Reads a square "matrix coordinate" file (real, integer or pattern; general or
+// symmetric / skew-symmetric, the missing triangle is mirrored) into A.
+// The file is mapped, not read. The data section is cut into one chunk per thread at
+// line boundaries: the threads count their entries, a prefix sum gives every thread its
+// output offset, and the entries are parsed with from_chars straight into place. CSR is
+// then built in parallel: row counts with atomic increments, a prefix sum, an atomic
+// scatter and a per-row sort by column.
+// Returns false with a message in *error if the file can not be used, including when
+// any entry line is malformed or has an index out of range.
+inline bool loadMatrixMarket(const std::string &path, CsrMatrix &A, int n_threads, std::string *error = nullptr)
+{
+    auto fail = [&](const std::string &message) {
+        if (error != nullptr)
+            *error = path + ": " + message;
+        return false;
+    };
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return fail("can not open");
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        return fail("empty or unreadable");
+    }
+    size_t length = st.st_size;
+    void *mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+        return fail("mmap failed");
+    madvise(mapped, length, MADV_SEQUENTIAL);
+    const char *begin = static_cast<const char *>(mapped);
+    const char *end = begin + length;
+
+    // banner, comments, size line
+    const char *p = begin;
+    const char *eol = static_cast<const char *>(memchr(p, '\n', end - p));
+    std::string banner(p, eol ? eol : end);
+    std::transform(banner.begin(), banner.end(), banner.begin(), ::tolower);
+    if (banner.rfind("%%matrixmarket matrix coordinate", 0) != 0)
+    {
+        munmap(mapped, length);
+        return fail("not a coordinate Matrix Market file");
+    }
+    const bool pattern = banner.find("pattern") != std::string::npos;
+    const bool complex = banner.find("complex") != std::string::npos;
+    const bool skew = banner.find("skew-symmetric") != std::string::npos;
+    const bool symmetric = skew || banner.find("symmetric") != std::string::npos ||
+                           banner.find("hermitian") != std::string::npos;
+    if (complex)
+    {
+        munmap(mapped, length);
+        return fail("complex matrices are not supported");
+    }
+
+    while (eol != nullptr && eol + 1 < end && eol[1] == '%')
+    {
+        eol = static_cast<const char *>(memchr(eol + 1, '\n', end - eol - 1));
+    }
+    int rows = 0, cols = 0;
+    long long declared = 0;
+    if (eol != nullptr)
+    {
+        p = skipSpaces(eol + 1, end);
+        auto r = std::from_chars(p, end, rows);
+        r = std::from_chars(skipSpaces(r.ptr, end), end, cols);
+        r = std::from_chars(skipSpaces(r.ptr, end), end, declared);
+        eol = static_cast<const char *>(memchr(r.ptr, '\n', end - r.ptr));
+    }
+    if (rows <= 0 || rows != cols)
+    {
+        munmap(mapped, length);
+        return fail("missing size line or matrix is not square");
+    }
+    const char *data = (eol != nullptr) ? eol + 1 : end;
+
+    // chunk boundaries at line starts
+    std::vector<const char *> chunk(n_threads + 1);
+    chunk[0] = data;
+    chunk[n_threads] = end;
+    for (int t = 1; t < n_threads; ++t)
+    {
+        const char *q = data + (end - data) * t / n_threads;
+        if (q > chunk[t - 1])
+        {
+            const char *nl = static_cast<const char *>(memchr(q - 1, '\n', end - q + 1));
+            q = (nl != nullptr) ? nl + 1 : end;
+        }
+        chunk[t] = std::max(q, chunk[t - 1]);
+    }
+
+    std::vector<size_t> offset(n_threads + 1, 0);
+    std::vector<MatrixMarketEntry> entries;
+    bool malformed = false;
+
+    #pragma omp parallel num_threads(n_threads)
+    {
+        int t = omp_get_thread_num();
+
+        size_t count = 0;
+        for (const char *q = chunk[t]; q < chunk[t + 1];)
+        {
+            const char *nl = static_cast<const char *>(memchr(q, '\n', chunk[t + 1] - q));
+            const char *line_end = (nl != nullptr) ? nl : chunk[t + 1];
+            if (isEntryLine(q, line_end))
+                ++count;
+            q = line_end + 1;
+        }
+        offset[t + 1] = count;
+
+        #pragma omp barrier
+        #pragma omp single
+        {
+            for (int k = 0; k < n_threads; ++k)
+            {
+                offset[k + 1] += offset[k];
+            }
+            entries.resize(offset[n_threads]);
+        }
+
+        size_t k = offset[t];
+        for (const char *q = chunk[t]; q < chunk[t + 1];)
+        {
+            const char *nl = static_cast<const char *>(memchr(q, '\n', chunk[t + 1] - q));
+            const char *line_end = (nl != nullptr) ? nl : chunk[t + 1];
+            if (isEntryLine(q, line_end))
+            {
+                MatrixMarketEntry e;
+                if (parseEntry(q, line_end, pattern, rows, e))
+                {
+                    entries[k] = e;
+                }
+                else
+                {
+                    #pragma omp atomic write
+                    malformed = true;
+                }
+                ++k;
+            }
+            q = line_end + 1;
+        }
+    }
+    munmap(mapped, length);
+
+    if (malformed)
+        return fail("malformed entry line or entry index out of range");
+    if ((long long)entries.size() != declared)
+        return fail("entry count does not match the size line");
+
+    // CSR: count, prefix sum, scatter, sort rows
+    const size_t m = entries.size();
+    A.n = rows;
+    std::vector<std::atomic<size_t>> fill(rows + 1);
+    for (int i = 0; i <= rows; ++i)
+    {
+        fill[i].store(0, std::memory_order_relaxed);
+    }
+
+    #pragma omp parallel for schedule(static) num_threads(n_threads)
+    for (size_t k = 0; k < m; ++k)
+    {
+        const MatrixMarketEntry &e = entries[k];
+        fill[e.row + 1].fetch_add(1, std::memory_order_relaxed);
+        if (symmetric && e.row != e.col)
+            fill[e.col + 1].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    A.row_ptr.assign(rows + 1, 0);
+    for (int i = 0; i < rows; ++i)
+    {
+        A.row_ptr[i + 1] = A.row_ptr[i] + fill[i + 1].load(std::memory_order_relaxed);
+        fill[i].store(A.row_ptr[i], std::memory_order_relaxed);
+    }
+    A.col.resize(A.row_ptr[rows]);
+    A.val.resize(A.row_ptr[rows]);
+
+    #pragma omp parallel num_threads(n_threads)
+    {
+        #pragma omp for schedule(static)
+        for (size_t k = 0; k < m; ++k)
+        {
+            const MatrixMarketEntry &e = entries[k];
+            size_t pos = fill[e.row].fetch_add(1, std::memory_order_relaxed);
+            A.col[pos] = e.col;
+            A.val[pos] = e.val;
+            if (symmetric && e.row != e.col)
+            {
+                pos = fill[e.col].fetch_add(1, std::memory_order_relaxed);
+                A.col[pos] = e.row;
+                A.val[pos] = skew ? -e.val : e.val;
+            }
+        }
+
+        std::vector<std::pair<int, double>> row;
+        #pragma omp for schedule(dynamic, 256)
+        for (int i = 0; i < rows; ++i)
+        {
+            size_t lb = A.row_ptr[i], ub = A.row_ptr[i + 1];
+            row.clear();
+            for (size_t k = lb; k < ub; ++k)
+            {
+                row.emplace_back(A.col[k], A.val[k]);
+            }
+            std::sort(row.begin(), row.end());
+            for (size_t k = lb; k < ub; ++k)
+            {
+                A.col[k] = row[k - lb].first;
+                A.val[k] = row[k - lb].second;
+            }
+        }
+    }
+    return true;
+}
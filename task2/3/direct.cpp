@@ -0,0 +1,117 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <time.h>
+#include <omp.h>
+
+#include "matrix.hpp"
+#include "iteration.hpp"
+#include "direct.hpp"
+
+#define N_THREADS 8
+#define REPEATS 10
+
+using namespace std;
+
+const double EPSILON = 1e-5;
+const double TAU = 0.000001;
+
+double relativeResidual(const Matrix &A, const Vector &b, const Vector &x)
+{
+    double rr = 0.0, bb = 0.0;
+    for (int i = 0; i < A.size(); ++i)
+    {
+        double r = rowDot(A, i, x.data()) - b[i];
+        rr += r * r;
+        bb += b[i] * b[i];
+    }
+    return sqrt(rr / bb);
+}
+
+int main()
+{
+    int N;
+    cout << "Enter the number of equations (N = 5000 as an example): ";
+    cin >> N;
+
+    if (N <= 0)
+    {
+        cout << "Error: N must be greater than 0" << endl;
+        return 1;
+    }
+
+    Matrix A(N, 1.0);
+    for (int i = 0; i < N; ++i)
+    {
+        A[i][i] = 2.0;
+    }
+
+    // REPEATS right-hand sides, all different. Only the first one is the task's b; the
+    // others are perturbed, which the simple iteration with the tiny TAU would take
+    // practically forever to resolve, so it solves B[0] only.
+    vector<Vector> B(REPEATS, Vector(N, N + 1));
+    for (int r = 1; r < REPEATS; ++r)
+    {
+        for (int i = 0; i < N; ++i)
+        {
+            B[r][i] += sin(0.1 * r * i);
+        }
+    }
+
+    double t = omp_get_wtime();
+    Vector x_simple = simpleIterationMethodFused(A, B[0], TAU, EPSILON, N_THREADS);
+    double t_simple = omp_get_wtime() - t;
+    printf("Simple iteration, one solve: %.6f sec, residual %.2e\n", t_simple, relativeResidual(A, B[0], x_simple));
+
+    std::ofstream out("Out_direct.txt");
+    out << "# method  factor_time  solve_time\n";
+
+    FactorizationCache cache;
+    const FactorKind kinds[] = {FactorKind::Cholesky, FactorKind::LU};
+    for (FactorKind kind : kinds)
+    {
+        const char *name = (kind == FactorKind::Cholesky) ? "Cholesky" : "LU";
+
+        t = omp_get_wtime();
+        const Factorization &f = cache.get(A, kind, N_THREADS);
+        double t_factor = omp_get_wtime() - t;
+
+        double t_solves = 0.0, worst = 0.0;
+        for (int r = 0; r < REPEATS; ++r)
+        {
+            t = omp_get_wtime();
+            Vector x;
+            bool solved = cache.solve(A, B[r], kind, N_THREADS, x);
+            t_solves += omp_get_wtime() - t;
+            worst = solved ? max(worst, relativeResidual(A, B[r], x)) : INFINITY;
+        }
+
+        printf("%-8s: factor %.6f sec (%s), %d solves %.6f sec each, worst residual %.2e | first solve speedup %.1f, repeated %.1f\n",
+               name, t_factor, f.ok ? "ok" : "FAILED", REPEATS, t_solves / REPEATS, worst,
+               t_simple / (t_factor + t_solves / REPEATS), t_simple / (t_solves / REPEATS));
+        out << name << "\t" << t_factor << "\t" << t_solves / REPEATS << "\n";
+    }
+    printf("Cache: %d factorizations, %d reuses\n", cache.misses, cache.hits);
+
+    // Matrices built one after another in the same scope usually get the same address and
+    // the same buffer; diagonal 2, 3 and -0.5 (indefinite: Cholesky fails, LU takes over).
+    const double diagonals[] = {2.0, 3.0, -0.5};
+    for (double d : diagonals)
+    {
+        Matrix C(N, 1.0);
+        for (int i = 0; i < N; ++i)
+        {
+            C[i][i] = d;
+        }
+        Vector x;
+        bool solved = cache.solve(C, B[0], FactorKind::Cholesky, N_THREADS, x);
+        printf("Diagonal %4.1f: %s, residual %.2e\n", d, solved ? "solved" : "singular",
+               solved ? relativeResidual(C, B[0], x) : INFINITY);
+    }
+    printf("Cache: %d factorizations, %d reuses\n", cache.misses, cache.hits);
+
+    out.close();
+    cout << "File has been written" << std::endl;
+    return 0;
+}
@@ -0,0 +1,402 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <omp.h>
+
+#include "hash.hpp"
+#include "matrix.hpp"
+#include "preconditioner.hpp"
+
+#define FACTOR_BLOCK 128 // tile size of the blocked factorizations
+
+enum class FactorKind
+{
+    Cholesky,
+    LU
+};
+
+// Factor of A stored the way forwardSolve / backwardSolve read it:
+// Cholesky: L in the lower triangle and L^T mirrored into the upper one, A = L L^T;
+// LU:       unit L strictly below the diagonal, U on and above it, P A = L U,
+//           perm[i] = row of A that ended up in row i.
+// lower_diag / upper_diag are the diagonals of the two triangles (ones for unit L).
+struct Factorization
+{
+    FactorKind kind = FactorKind::Cholesky;
+    bool ok = false; // false: A not positive definite (Cholesky) or singular (LU)
+    Matrix F;
+    Vector lower_diag;
+    Vector upper_diag;
+    std::vector<int> perm;
+};
+
+// ---- Cholesky tile kernels, tile (I, J) = rows I * nb .., columns J * nb .. ----
+
+// L_kk = chol(A_kk), in place, lower triangle
+inline bool tilePotrf(Matrix &F, int k0, int kn)
+{
+    for (int c = k0; c < k0 + kn; ++c)
+    {
+        double d = F[c][c];
+        for (int l = k0; l < c; ++l)
+        {
+            d -= F[c][l] * F[c][l];
+        }
+        if (d <= 0.0)
+            return false;
+        d = sqrt(d);
+        F[c][c] = d;
+        for (int r = c + 1; r < k0 + kn; ++r)
+        {
+            double sum = F[r][c];
+            for (int l = k0; l < c; ++l)
+            {
+                sum -= F[r][l] * F[c][l];
+            }
+            F[r][c] = sum / d;
+        }
+    }
+    return true;
+}
+
+// A_ik := A_ik L_kk^{-T}
+inline void tileTrsm(Matrix &F, int i0, int in, int k0, int kn)
+{
+    for (int r = i0; r < i0 + in; ++r)
+    {
+        double *row = F[r];
+        for (int c = k0; c < k0 + kn; ++c)
+        {
+            const double *lc = F[c];
+            double sum = row[c];
+            for (int l = k0; l < c; ++l)
+            {
+                sum -= row[l] * lc[l];
+            }
+            row[c] = sum / lc[c];
+        }
+    }
+}
+
+// A_ij -= L_ik L_jk^T (only the lower triangle when i == j)
+inline void tileUpdate(Matrix &F, int i0, int in, int j0, int jn, int k0, int kn)
+{
+    for (int r = i0; r < i0 + in; ++r)
+    {
+        double *row = F[r];
+        int c_end = (i0 == j0) ? r + 1 : j0 + jn;
+        for (int c = j0; c < c_end; ++c)
+        {
+            const double *lc = F[c];
+            double sum = 0.0;
+            for (int l = k0; l < k0 + kn; ++l)
+            {
+                sum += row[l] * lc[l];
+            }
+            row[c] -= sum;
+        }
+    }
+}
+
+// Right-looking tiled Cholesky. One task per tile operation, ordered only by data
+// dependencies on the tiles (one sentinel per tile), so the panel of step k + 1 can
+// start as soon as the tiles it needs are updated, while the rest of step k is still
+// running.
+inline void choleskyFactor(const Matrix &A, int n_threads, Factorization &f)
+{
+    int n = A.size();
+    const int nb = FACTOR_BLOCK;
+    const int nt = (n + nb - 1) / nb;
+    f.kind = FactorKind::Cholesky;
+    f.F = A;
+    Matrix &F = f.F;
+    std::vector<char> tile(nt * nt); // dependency sentinels, one per tile
+    char *dep = tile.data();
+    (void)dep; // only referenced in depend clauses, which -Wunused-variable does not see
+    bool ok = true;
+
+    #pragma omp parallel num_threads(n_threads)
+    #pragma omp single
+    for (int k = 0; k < nt; ++k)
+    {
+        const int k0 = k * nb, kn = std::min(nb, n - k0);
+
+        #pragma omp task depend(inout: dep[k * nt + k]) shared(F, ok)
+        {
+            if (!tilePotrf(F, k0, kn))
+            {
+                #pragma omp atomic write
+                ok = false;
+            }
+        }
+
+        for (int i = k + 1; i < nt; ++i)
+        {
+            const int i0 = i * nb, in = std::min(nb, n - i0);
+            #pragma omp task depend(in: dep[k * nt + k]) depend(inout: dep[i * nt + k]) shared(F)
+            tileTrsm(F, i0, in, k0, kn);
+        }
+
+        for (int i = k + 1; i < nt; ++i)
+        {
+            const int i0 = i * nb, in = std::min(nb, n - i0);
+            for (int j = k + 1; j <= i; ++j)
+            {
+                const int j0 = j * nb, jn = std::min(nb, n - j0);
+                #pragma omp task depend(in: dep[i * nt + k], dep[j * nt + k]) depend(inout: dep[i * nt + j]) shared(F)
+                tileUpdate(F, i0, in, j0, jn, k0, kn);
+            }
+        }
+    }
+
+    f.ok = ok;
+    f.lower_diag.resize(n);
+    f.perm.clear();
+
+    // mirror L^T into the upper triangle so the backward sweep reads rows
+    #pragma omp parallel for schedule(static) num_threads(n_threads)
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = i + 1; j < n; ++j)
+        {
+            F[i][j] = F[j][i];
+        }
+        f.lower_diag[i] = F[i][i];
+    }
+    f.upper_diag = f.lower_diag;
+}
+
+// ---- LU kernels, column block k = columns k * nb .. ----
+
+// Unblocked LU with partial pivoting of the panel (all rows from k0 down, columns of
+// block k). Row swaps are applied inside the panel only, pivots recorded in piv.
+inline bool panelLU(Matrix &F, int k0, int kn, std::vector<int> &piv)
+{
+    int n = F.size();
+    bool ok = true;
+    for (int c = k0; c < k0 + kn; ++c)
+    {
+        int p = c;
+        for (int r = c + 1; r < n; ++r)
+        {
+            if (fabs(F[r][c]) > fabs(F[p][c]))
+                p = r;
+        }
+        piv[c] = p;
+        if (p != c)
+        {
+            std::swap_ranges(F[c] + k0, F[c] + k0 + kn, F[p] + k0);
+        }
+        double d = F[c][c];
+        if (d == 0.0)
+        {
+            ok = false;
+            continue;
+        }
+        for (int r = c + 1; r < n; ++r)
+        {
+            double *row = F[r];
+            double l = row[c] / d;
+            row[c] = l;
+            for (int j = c + 1; j < k0 + kn; ++j)
+            {
+                row[j] -= l * F[c][j];
+            }
+        }
+    }
+    return ok;
+}
+
+// Apply the swaps of panel k to columns [j0, j0 + jn)
+inline void applySwaps(Matrix &F, const std::vector<int> &piv, int k0, int kn, int j0, int jn)
+{
+    for (int c = k0; c < k0 + kn; ++c)
+    {
+        if (piv[c] != c)
+        {
+            std::swap_ranges(F[c] + j0, F[c] + j0 + jn, F[piv[c]] + j0);
+        }
+    }
+}
+
+// Column block j after panel k: swaps, U_kj = L_kk^{-1} A_kj, then A_ij -= L_ik U_kj below
+inline void columnUpdate(Matrix &F, const std::vector<int> &piv, int k0, int kn, int j0, int jn)
+{
+    int n = F.size();
+    applySwaps(F, piv, k0, kn, j0, jn);
+
+    for (int r = k0 + 1; r < k0 + kn; ++r)
+    {
+        double *row = F[r];
+        for (int l = k0; l < r; ++l)
+        {
+            const double a = row[l];
+            const double *ul = F[l];
+            for (int c = j0; c < j0 + jn; ++c)
+            {
+                row[c] -= a * ul[c];
+            }
+        }
+    }
+
+    for (int r = k0 + kn; r < n; ++r)
+    {
+        double *row = F[r];
+        for (int l = k0; l < k0 + kn; ++l)
+        {
+            const double a = row[l];
+            const double *ul = F[l];
+            for (int c = j0; c < j0 + jn; ++c)
+            {
+                row[c] -= a * ul[c];
+            }
+        }
+    }
+}
+
+// Right-looking blocked LU with partial pivoting. Pivoting needs whole columns, so the
+// tasks work on column blocks: the panel task of step k owns column block k, and one
+// task per other column block applies the step's swaps and (right of the panel) the
+// triangular solve and the trailing update. Dependencies are one sentinel per column
+// block, so panel k + 1 starts as soon as column block k + 1 is updated (look-ahead).
+inline void luFactor(const Matrix &A, int n_threads, Factorization &f)
+{
+    int n = A.size();
+    const int nb = FACTOR_BLOCK;
+    const int nt = (n + nb - 1) / nb;
+    f.kind = FactorKind::LU;
+    f.F = A;
+    Matrix &F = f.F;
+    std::vector<int> piv(n);
+    std::vector<char> column(nt); // dependency sentinels, one per column block
+    char *dep = column.data();
+    (void)dep;
+    bool ok = true;
+
+    #pragma omp parallel num_threads(n_threads)
+    #pragma omp single
+    for (int k = 0; k < nt; ++k)
+    {
+        const int k0 = k * nb, kn = std::min(nb, n - k0);
+
+        #pragma omp task depend(inout: dep[k]) shared(F, piv, ok)
+        {
+            if (!panelLU(F, k0, kn, piv))
+            {
+                #pragma omp atomic write
+                ok = false;
+            }
+        }
+
+        for (int j = 0; j < nt; ++j)
+        {
+            if (j == k)
+                continue;
+            const int j0 = j * nb, jn = std::min(nb, n - j0);
+            #pragma omp task depend(in: dep[k]) depend(inout: dep[j]) shared(F, piv)
+            {
+                if (j < k)
+                    applySwaps(F, piv, k0, kn, j0, jn);
+                else
+                    columnUpdate(F, piv, k0, kn, j0, jn);
+            }
+        }
+    }
+
+    f.ok = ok;
+    f.perm.resize(n);
+    for (int i = 0; i < n; ++i)
+    {
+        f.perm[i] = i;
+    }
+    for (int c = 0; c < n; ++c)
+    {
+        std::swap(f.perm[c], f.perm[piv[c]]);
+    }
+    f.lower_diag.assign(n, 1.0);
+    f.upper_diag.resize(n);
+    for (int i = 0; i < n; ++i)
+    {
+        f.upper_diag[i] = F[i][i];
+    }
+}
+
+// x = A^{-1} b from a factorization: permutation (LU), forward and backward sweep,
+// each sweep blocked and parallel as in preconditioner.hpp.
+inline Vector solveFactored(const Factorization &f, const Vector &b, int n_threads)
+{
+    int n = f.F.size();
+    Vector pb(n), y(n), x(n);
+
+    #pragma omp parallel num_threads(n_threads)
+    {
+        #pragma omp for schedule(static)
+        for (int i = 0; i < n; ++i)
+        {
+            pb[i] = f.perm.empty() ? b[i] : b[f.perm[i]];
+        }
+        forwardSolve(f.F, f.lower_diag.data(), pb.data(), y.data());
+        backwardSolve(f.F, f.upper_diag.data(), y.data(), x.data());
+    }
+    return x;
+}
+
+// Factorizations by matrix content: the key is a fingerprint of A (hashMatrix, one
+// parallel pass over A) with its size. Any change of A, in place or not, changes the key,
+// and a new matrix with the same content reuses the factor, whatever its address.
+// Entries stay until clear().
+class FactorizationCache
+{
+public:
+    const Factorization &get(const Matrix &A, FactorKind kind, int n_threads)
+    {
+        return get(A, hashMatrix(A, n_threads), kind, n_threads);
+    }
+
+    // x = A^{-1} b through the cached factorization. A Cholesky that fails (A not positive
+    // definite) is replaced by LU. Returns false, x untouched, if A is singular.
+    bool solve(const Matrix &A, const Vector &b, FactorKind kind, int n_threads, Vector &x)
+    {
+        const uint64_t fingerprint = hashMatrix(A, n_threads);
+        const Factorization *f = &get(A, fingerprint, kind, n_threads);
+        if (!f->ok && kind == FactorKind::Cholesky)
+            f = &get(A, fingerprint, FactorKind::LU, n_threads);
+        if (!f->ok)
+            return false;
+        x = solveFactored(*f, b, n_threads);
+        return true;
+    }
+
+    void clear() { entries.clear(); }
+
+    int hits = 0;
+    int misses = 0;
+
+private:
+    const Factorization &get(const Matrix &A, uint64_t fingerprint, FactorKind kind, int n_threads)
+    {
+        Key key{fingerprint, A.size(), kind};
+        auto it = entries.find(key);
+        if (it != entries.end())
+        {
+            ++hits;
+            return it->second;
+        }
+        ++misses;
+        Factorization &f = entries[key];
+        if (kind == FactorKind::Cholesky)
+            choleskyFactor(A, n_threads, f);
+        else
+            luFactor(A, n_threads, f);
+        return f;
+    }
+
+    using Key = std::tuple<uint64_t, int, FactorKind>;
+    std::map<Key, Factorization> entries;
+};
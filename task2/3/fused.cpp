@@ -0,0 +1,106 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <time.h>
+#include <omp.h>
+
+#include "matrix.hpp"
+#include "iteration.hpp"
+
+#define N_THREADS 8
+#define N 5000
+
+using namespace std;
+
+const double EPSILON = 1e-5;
+const double TAU = 0.000001;
+
+double norm(const Vector &v, int n_threads)
+{
+    double sum = 0.0;
+    #pragma omp parallel for reduction(+:sum) num_threads(n_threads)
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        sum += v[i] * v[i];
+    }
+    return sqrt(sum);
+}
+
+// task31 version, only an iteration counter added
+Vector simpleIterationMethod(const Matrix &A, const Vector &b, int n_threads, int *iterations)
+{
+    int n = A.size();
+    Vector x(n, 0.0);
+    Vector Ax(n);
+    int iter = 0;
+
+    while (true)
+    {
+        Vector result(n, 0.0);
+        #pragma omp parallel for num_threads(n_threads)
+        for (int i = 0; i < n; ++i)
+        {
+            for (int j = 0; j < n; ++j)
+            {
+                result[i] += A[i][j] * x[j];
+            }
+        }
+        Ax = result;
+
+        Vector r(n);
+        #pragma omp parallel for num_threads(n_threads)
+        for (int i = 0; i < n; ++i)
+        {
+            r[i] = Ax[i] - b[i];
+        }
+
+        if (norm(r, n_threads) / norm(b, n_threads) < EPSILON)
+        {
+            break;
+        }
+
+        #pragma omp parallel for num_threads(n_threads)
+        for (int i = 0; i < n; ++i)
+        {
+            x[i] -= TAU * r[i];
+        }
+        ++iter;
+    }
+
+    *iterations = iter;
+    return x;
+}
+
+int main()
+{
+    Matrix A(N, 1.0);
+    Vector b(N, N + 1);
+    for (int i = 0; i < N; ++i)
+    {
+        A[i][i] = 2.0;
+    }
+
+    int iter_old, iter_fused;
+
+    double t = omp_get_wtime();
+    Vector x_old = simpleIterationMethod(A, b, N_THREADS, &iter_old);
+    double t_old = omp_get_wtime() - t;
+
+    t = omp_get_wtime();
+    Vector x_fused = simpleIterationMethodFused(A, b, TAU, EPSILON, N_THREADS, &iter_fused);
+    double t_fused = omp_get_wtime() - t;
+
+    double diff = 0.0;
+    for (int i = 0; i < N; ++i)
+    {
+        diff = max(diff, fabs(x_old[i] - x_fused[i]));
+    }
+
+    printf("N: %d | Threads: %d | Max difference: %.3e\n", N, N_THREADS, diff);
+    printf("Current: %d iterations, %.6f sec, %.3f ms/iteration\n", iter_old, t_old, 1e3 * t_old / (iter_old + 1));
+    printf("Fused:   %d iterations, %.6f sec, %.3f ms/iteration\n", iter_fused, t_fused, 1e3 * t_fused / (iter_fused + 1));
+    printf("Speedup per iteration: %.2f\n", (t_old / (iter_old + 1)) / (t_fused / (iter_fused + 1)));
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <omp.h>
+
+#include "matrix.hpp"
+
+#define HASH_BLOCK 4096 // vector elements per hash block
+
+// splitmix64 finalizer
+inline uint64_t mix64(uint64_t z)
+{
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Position-dependent sum of the bit patterns: no dependency chain between the elements,
+// so it runs at multiply throughput; mix64 is applied once per row / block.
+inline uint64_t hashWords(const double *v, int n)
+{
+    uint64_t h = 0;
+    for (int j = 0; j < n; ++j)
+    {
+        uint64_t bits;
+        memcpy(&bits, v + j, sizeof(bits));
+        h += (bits ^ (bits >> 29)) * (0x9E3779B97F4A7C15ULL * (2 * (uint64_t)j + 1));
+    }
+    return h;
+}
+
+// Not cryptographic: identical data gives identical keys, and a change in any element
+// changes the key with overwhelming probability. Rows (blocks) are hashed in parallel and
+// combined by a sum, with the row index mixed in so that swapped rows differ.
+inline uint64_t hashMatrix(const Matrix &A, int n_threads)
+{
+    int n = A.size();
+    uint64_t h = mix64(n);
+    #pragma omp parallel for reduction(+:h) schedule(static) num_threads(n_threads)
+    for (int i = 0; i < n; ++i)
+    {
+        h += mix64(hashWords(A[i], n) ^ ((uint64_t)i * 0xD6E8FEB86659FD93ULL));
+    }
+    return h;
+}
+
+inline uint64_t hashVector(const Vector &v, int n_threads)
+{
+    int n = v.size();
+    int blocks = (n + HASH_BLOCK - 1) / HASH_BLOCK;
+    uint64_t h = mix64(n);
+    #pragma omp parallel for reduction(+:h) schedule(static) num_threads(n_threads)
+    for (int k = 0; k < blocks; ++k)
+    {
+        int lb = k * HASH_BLOCK;
+        int len = (lb + HASH_BLOCK < n) ? HASH_BLOCK : n - lb;
+        h += mix64(hashWords(v.data() + lb, len) ^ ((uint64_t)k * 0xD6E8FEB86659FD93ULL));
+    }
+    return h;
+}
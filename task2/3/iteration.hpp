@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cmath>
+#include <utility>
+#include <omp.h>
+
+#include "matrix.hpp"
+
+// Simple iteration x_{k+1} = x_k - TAU * (A x_k - b), fused: for every row the product
+// (A x)_i, the residual r_i, its square for the norm and the new x_i are computed in a
+// single pass. The new x goes into a second buffer (other threads still read the old x
+// in the same pass), and the two buffers are swapped once per iteration.
+// All workspaces are allocated once per solve, and ||b|| is computed once.
+// Rows are split into per-thread parts by rowBegin (nonzero-balanced for sparse A).
+// The iteration starts from x0 if given (see warmstart.hpp), from zero otherwise.
+template <typename Op>
+Vector simpleIterationMethodFused(const Op &A, const Vector &b, double tau, double epsilon, int n_threads,
+                                  int *iterations = nullptr, const Vector *x0 = nullptr)
+{
+    int n = A.size();
+    Vector x = (x0 != nullptr) ? *x0 : Vector(n, 0.0);
+    Vector x_next(n);
+    double b_norm2 = 0.0;
+    double r_norm2 = 0.0;
+    int iter = 0;
+    bool stop = false;
+
+    #pragma omp parallel num_threads(n_threads)
+    {
+        #pragma omp for reduction(+:b_norm2)
+        for (int i = 0; i < n; ++i)
+        {
+            b_norm2 += b[i] * b[i];
+        }
+
+        while (true)
+        {
+            const double *xp = x.data();
+            double *xn = x_next.data();
+
+            const int parts = omp_get_num_threads();
+            #pragma omp for reduction(+:r_norm2) schedule(static, 1)
+            for (int part = 0; part < parts; ++part)
+            {
+                const int end = rowBegin(A, part + 1, parts);
+                for (int i = rowBegin(A, part, parts); i < end; ++i)
+                {
+                    double r = rowDot(A, i, xp) - b[i];
+                    r_norm2 += r * r;
+                    xn[i] = xp[i] - tau * r;
+                }
+            }
+
+            #pragma omp single
+            {
+                if (sqrt(r_norm2 / b_norm2) < epsilon)
+                {
+                    stop = true;
+                }
+                else
+                {
+                    x.swap(x_next);
+                    ++iter;
+                }
+                r_norm2 = 0.0;
+            }
+
+            if (stop)
+                break;
+        }
+    }
+
+    if (iterations != nullptr)
+    {
+        *iterations = iter;
+    }
+    return x;
+}
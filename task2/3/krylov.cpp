@@ -0,0 +1,133 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <time.h>
+#include <omp.h>
+
+#include "matrix.hpp"
+#include "iteration.hpp"
+#include "krylov.hpp"
+
+#define N_THREADS 8
+#define RESTART 30
+
+using namespace std;
+
+const double EPSILON = 1e-5;
+const double TAU = 0.000001;
+const double TAU_NONSYMMETRIC = 1.0 / 3.0; // 2 / (lambda_min + lambda_max) for the matrix below
+
+double relativeResidual(const Matrix &A, const Vector &b, const Vector &x)
+{
+    double rr = 0.0, bb = 0.0;
+    for (int i = 0; i < A.size(); ++i)
+    {
+        double r = rowDot(A, i, x.data()) - b[i];
+        rr += r * r;
+        bb += b[i] * b[i];
+    }
+    return sqrt(rr / bb);
+}
+
+// Upwind-like nonsymmetric matrix: 3 on the diagonal, -2 below, -0.5 above. Its eigenvalues
+// 3 - 2 cos(k pi / (N + 1)) lie in [1, 5], but it is far from normal.
+void initializeNonsymmetricSystem(Matrix &A, Vector &b, int N)
+{
+    A.assign(N, 0.0);
+    for (int i = 0; i < N; ++i)
+    {
+        A[i][i] = 3.0;
+        if (i > 0)
+            A[i][i - 1] = -2.0;
+        if (i + 1 < N)
+            A[i][i + 1] = -0.5;
+    }
+    b.assign(N, 1.0);
+}
+
+// Regression run: an unreachable epsilon on the 1D Laplacian (N = 400), so GMRES(RESTART)
+// goes through KRYLOV_MAX_ITERATIONS Arnoldi steps. It used to run out of stack long
+// before that (a per-step stack allocation for the array reductions).
+void runToIterationCap()
+{
+    const int n = 400;
+    Matrix A(n, 0.0);
+    Vector b(n, 1.0);
+    for (int i = 0; i < n; ++i)
+    {
+        A[i][i] = 2.0;
+        if (i > 0)
+            A[i][i - 1] = -1.0;
+        if (i + 1 < n)
+            A[i][i + 1] = -1.0;
+    }
+
+    int it;
+    double t = omp_get_wtime();
+    Vector x = gmresMethod(A, b, RESTART, 1e-20, N_THREADS, &it);
+    t = omp_get_wtime() - t;
+    printf("iteration cap (1D Laplacian, N %d, epsilon 1e-20)\n", n);
+    printf("  GMRES(%d): %7d it (%s KRYLOV_MAX_ITERATIONS) | %.6f sec | residual %.2e\n", RESTART, it,
+           it >= KRYLOV_MAX_ITERATIONS ? "reached" : "did not reach", t, relativeResidual(A, b, x));
+}
+
+void run(const char *name, const Matrix &A, const Vector &b, double tau, std::ofstream &out)
+{
+    KrylovWorkspace workspace;
+    int it_simple, it_gmres, it_bicgstab;
+
+    double t = omp_get_wtime();
+    Vector x_simple = simpleIterationMethodFused(A, b, tau, EPSILON, N_THREADS, &it_simple);
+    double t_simple = omp_get_wtime() - t;
+
+    t = omp_get_wtime();
+    Vector x_gmres = gmresMethod(A, b, RESTART, EPSILON, N_THREADS, &it_gmres, &workspace);
+    double t_gmres = omp_get_wtime() - t;
+
+    t = omp_get_wtime();
+    Vector x_bicgstab = biCGStabMethod(A, b, EPSILON, N_THREADS, &it_bicgstab, &workspace);
+    double t_bicgstab = omp_get_wtime() - t;
+
+    printf("%s\n", name);
+    printf("  Simple iteration (tau %g): %7d it | %.6f sec | residual %.2e\n", tau, it_simple, t_simple,
+           relativeResidual(A, b, x_simple));
+    printf("  GMRES(%d):                  %7d it | %.6f sec | residual %.2e | Speedup: %.1f\n", RESTART, it_gmres,
+           t_gmres, relativeResidual(A, b, x_gmres), t_simple / t_gmres);
+    printf("  BiCGSTAB:                   %7d it | %.6f sec | residual %.2e | Speedup: %.1f\n", it_bicgstab,
+           t_bicgstab, relativeResidual(A, b, x_bicgstab), t_simple / t_bicgstab);
+    out << name << "\t" << t_simple << "\t" << t_gmres << "\t" << t_bicgstab << "\n";
+}
+
+int main()
+{
+    int N;
+    cout << "Enter the number of equations (N = 5000 as an example): ";
+    cin >> N;
+
+    if (N <= 0)
+    {
+        cout << "Error: N must be greater than 0" << endl;
+        return 1;
+    }
+
+    std::ofstream out("Out_krylov.txt");
+    out << "# system  simple_time  gmres_time  bicgstab_time\n";
+
+    Matrix A(N, 1.0);
+    Vector b(N, N + 1);
+    for (int i = 0; i < N; ++i)
+    {
+        A[i][i] = 2.0;
+    }
+    run("task matrix", A, b, TAU, out);
+
+    initializeNonsymmetricSystem(A, b, N);
+    run("nonsymmetric", A, b, TAU_NONSYMMETRIC, out);
+
+    runToIterationCap();
+
+    out.close();
+    cout << "File has been written" << std::endl;
+    return 0;
+}
@@ -0,0 +1,439 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <omp.h>
+
+#include "matrix.hpp"
+#include "preconditioner.hpp"
+
+#define KRYLOV_MAX_ITERATIONS 100000 // iterations before a nonsymmetric solver gives up
+#define GMRES_MAX_RESTART 64         // largest m accepted by gmresMethod (size of the dot product buffers)
+
+// Vectors of length n in one block, vector k at [k * n]. Both solvers below keep all their
+// work vectors in one, so a caller solving several systems of the same size can pass the
+// same workspace every time and nothing is allocated per solve.
+class KrylovWorkspace
+{
+public:
+    KrylovWorkspace() : n(0), count(0) {}
+
+    KrylovWorkspace(int size, int vectors) : n(0), count(0) { reserve(size, vectors); }
+
+    void reserve(int size, int vectors)
+    {
+        if (size == n && vectors <= count)
+            return;
+        n = size;
+        count = vectors;
+        storage.assign((size_t)n * count, 0.0);
+    }
+
+    double *operator[](int k) { return storage.data() + (size_t)k * n; }
+
+private:
+    int n;
+    int count;
+    Vector storage;
+};
+
+// Restarted GMRES(m) for nonsymmetric A. Stopping rule as everywhere else,
+// ||A x - b|| / ||b|| < epsilon: the Arnoldi estimate |g_j| inside a cycle, the true
+// residual at every restart.
+// Orthogonalization is classical Gram-Schmidt applied twice (CGS2). Every projection is a
+// batch of j + 1 dot products computed in one pass (array reduction), so an Arnoldi step
+// takes the same four passes whatever j is:
+//   w = A v_j together with h = V^T w,
+//   w -= V h together with h2 = V^T w,
+//   w -= V h2 together with ||w||^2,
+//   v_{j+1} = w / ||w||.
+// Modified Gram-Schmidt would need j + 1 passes, each ending in a reduction.
+// The reduced sections have the fixed length GMRES_MAX_RESTART: with a length that
+// changes every step GCC allocates the private copies on the stack anew for each
+// step (alloca inside the loop) and a long solve overflows the stack.
+// Products with A run over rowBegin parts, one per thread, in both solvers.
+// Both take an optional preconditioner M and apply it from the right, A M^{-1} u = b,
+// x = M^{-1} u: the residual they monitor stays the residual of A x = b, so the
+// stopping rule does not change. It costs one M->apply pass before every product with A
+// (and one per restart for the update of x in GMRES).
+template <typename Op>
+Vector gmresMethod(const Op &A, const Vector &b, int m, double epsilon, int n_threads, int *iterations = nullptr,
+                   KrylovWorkspace *workspace = nullptr, const Preconditioner *M = nullptr)
+{
+    int n = A.size();
+    if (m > GMRES_MAX_RESTART)
+        m = GMRES_MAX_RESTART;
+
+    KrylovWorkspace local;
+    KrylovWorkspace &ws = (workspace != nullptr) ? *workspace : local;
+    ws.reserve(n, (M != nullptr) ? m + 3 : m + 2); // v_0 .. v_m, w and with M z = M^{-1} v_j
+    double *V = ws[0];
+    double *w = ws[m + 1];
+    double *z = (M != nullptr) ? ws[m + 2] : nullptr;
+
+    Vector x(n, 0.0);
+    std::vector<Vector> H(m + 1, Vector(m, 0.0)); // H[row][column], rotated into R in place
+    Vector cs(m), sn(m), g(m + 1), y(m);
+    double h[GMRES_MAX_RESTART];
+    double h2[GMRES_MAX_RESTART];
+    double b_norm2 = 0.0;
+    double r_norm2 = 0.0;
+    double w_norm2 = 0.0;
+    double w_norm = 0.0;
+    int iter = 0;
+    int j = 0;
+    bool stop = false;
+    bool restart = false;
+
+    #pragma omp parallel num_threads(n_threads)
+    {
+        #pragma omp for reduction(+:b_norm2)
+        for (int i = 0; i < n; ++i)
+        {
+            b_norm2 += b[i] * b[i];
+        }
+
+        while (true)
+        {
+            // r = b - A x into v_0
+            const int parts = omp_get_num_threads();
+            #pragma omp for reduction(+:r_norm2) schedule(static, 1)
+            for (int part = 0; part < parts; ++part)
+            {
+                const int end = rowBegin(A, part + 1, parts);
+                for (int i = rowBegin(A, part, parts); i < end; ++i)
+                {
+                    V[i] = b[i] - rowDot(A, i, x.data());
+                    r_norm2 += V[i] * V[i];
+                }
+            }
+
+            #pragma omp single
+            {
+                stop = sqrt(r_norm2 / b_norm2) < epsilon || iter >= KRYLOV_MAX_ITERATIONS;
+                g.assign(m + 1, 0.0);
+                g[0] = sqrt(r_norm2);
+                r_norm2 = 0.0;
+                j = 0;
+                restart = false;
+            }
+            if (stop)
+                break;
+
+            const double beta = g[0];
+            #pragma omp for schedule(static)
+            for (int i = 0; i < n; ++i)
+            {
+                V[i] /= beta;
+            }
+
+            while (!restart)
+            {
+                const int jj = j;
+                const double *vj = V + (size_t)jj * n;
+                if (M != nullptr)
+                {
+                    M->apply(vj, z);
+                    vj = z;
+                }
+
+                #pragma omp single
+                for (int k = 0; k <= jj; ++k)
+                {
+                    h[k] = 0.0;
+                    h2[k] = 0.0;
+                }
+
+                #pragma omp for reduction(+:h[:GMRES_MAX_RESTART]) schedule(static, 1)
+                for (int part = 0; part < parts; ++part)
+                {
+                    const int end = rowBegin(A, part + 1, parts);
+                    for (int i = rowBegin(A, part, parts); i < end; ++i)
+                    {
+                        w[i] = rowDot(A, i, vj);
+                        for (int k = 0; k <= jj; ++k)
+                        {
+                            h[k] += V[(size_t)k * n + i] * w[i];
+                        }
+                    }
+                }
+
+                #pragma omp for reduction(+:h2[:GMRES_MAX_RESTART]) schedule(static)
+                for (int i = 0; i < n; ++i)
+                {
+                    double wi = w[i];
+                    for (int k = 0; k <= jj; ++k)
+                    {
+                        wi -= h[k] * V[(size_t)k * n + i];
+                    }
+                    w[i] = wi;
+                    for (int k = 0; k <= jj; ++k)
+                    {
+                        h2[k] += V[(size_t)k * n + i] * wi;
+                    }
+                }
+
+                #pragma omp for reduction(+:w_norm2) schedule(static)
+                for (int i = 0; i < n; ++i)
+                {
+                    double wi = w[i];
+                    for (int k = 0; k <= jj; ++k)
+                    {
+                        wi -= h2[k] * V[(size_t)k * n + i];
+                    }
+                    w[i] = wi;
+                    w_norm2 += wi * wi;
+                }
+
+                // column jj of H: previous rotations, a new one zeroing H[jj + 1][jj], residual estimate
+                #pragma omp single
+                {
+                    for (int k = 0; k <= jj; ++k)
+                    {
+                        H[k][jj] = h[k] + h2[k];
+                    }
+                    w_norm = sqrt(w_norm2);
+                    w_norm2 = 0.0;
+
+                    for (int k = 0; k < jj; ++k)
+                    {
+                        double t = cs[k] * H[k][jj] + sn[k] * H[k + 1][jj];
+                        H[k + 1][jj] = -sn[k] * H[k][jj] + cs[k] * H[k + 1][jj];
+                        H[k][jj] = t;
+                    }
+                    double d = hypot(H[jj][jj], w_norm);
+                    cs[jj] = (d > 0.0) ? H[jj][jj] / d : 1.0;
+                    sn[jj] = (d > 0.0) ? w_norm / d : 0.0;
+                    H[jj][jj] = d;
+                    g[jj + 1] = -sn[jj] * g[jj];
+                    g[jj] = cs[jj] * g[jj];
+
+                    ++iter;
+                    j = jj + 1;
+                    restart = j == m || fabs(g[j]) / sqrt(b_norm2) < epsilon || w_norm == 0.0 ||
+                              iter >= KRYLOV_MAX_ITERATIONS;
+                }
+
+                if (!restart)
+                {
+                    double *vn = V + (size_t)(jj + 1) * n;
+                    #pragma omp for schedule(static)
+                    for (int i = 0; i < n; ++i)
+                    {
+                        vn[i] = w[i] / w_norm;
+                    }
+                }
+            }
+
+            // R y = g by back substitution, then x += V y (x += M^{-1} V y)
+            #pragma omp single
+            for (int k = j - 1; k >= 0; --k)
+            {
+                double sum = g[k];
+                for (int l = k + 1; l < j; ++l)
+                {
+                    sum -= H[k][l] * y[l];
+                }
+                y[k] = (H[k][k] != 0.0) ? sum / H[k][k] : 0.0;
+            }
+
+            if (M == nullptr)
+            {
+                #pragma omp for schedule(static)
+                for (int i = 0; i < n; ++i)
+                {
+                    double xi = x[i];
+                    for (int k = 0; k < j; ++k)
+                    {
+                        xi += y[k] * V[(size_t)k * n + i];
+                    }
+                    x[i] = xi;
+                }
+            }
+            else
+            {
+                #pragma omp for schedule(static)
+                for (int i = 0; i < n; ++i)
+                {
+                    double zi = 0.0;
+                    for (int k = 0; k < j; ++k)
+                    {
+                        zi += y[k] * V[(size_t)k * n + i];
+                    }
+                    z[i] = zi;
+                }
+
+                M->apply(z, w);
+
+                #pragma omp for schedule(static)
+                for (int i = 0; i < n; ++i)
+                {
+                    x[i] += w[i];
+                }
+            }
+        }
+    }
+
+    if (iterations != nullptr)
+    {
+        *iterations = iter;
+    }
+    return x;
+}
+
+// BiCGSTAB for nonsymmetric A, same stopping rule (recursively updated residual).
+// Two products with A per iteration; the dot products ride along with the passes that
+// produce their operands, so an iteration is five passes:
+//   p = r + beta (p - omega v),
+//   v = A p together with (r0, v),
+//   s = r - alpha v together with (s, s),
+//   t = A s together with (t, s) and (t, t),
+//   x += alpha p + omega s, r = s - omega t together with (r, r) and (r0, r).
+// Stops early (x += alpha p only) when s is already small enough, and on breakdown
+// ((r0, v), (t, t) or (r0, r) exactly zero).
+// With M the products are v = A M^{-1} p and t = A M^{-1} s, and x is updated with
+// M^{-1} p and M^{-1} s (ph and sh); without M those are p and s themselves.
+template <typename Op>
+Vector biCGStabMethod(const Op &A, const Vector &b, double epsilon, int n_threads, int *iterations = nullptr,
+                      KrylovWorkspace *workspace = nullptr, const Preconditioner *M = nullptr)
+{
+    int n = A.size();
+    KrylovWorkspace local;
+    KrylovWorkspace &ws = (workspace != nullptr) ? *workspace : local;
+    ws.reserve(n, (M != nullptr) ? 8 : 6);
+    double *r = ws[0];
+    double *r0 = ws[1];
+    double *p = ws[2];
+    double *v = ws[3];
+    double *s = ws[4];
+    double *t = ws[5];
+    double *ph = (M != nullptr) ? ws[6] : p;
+    double *sh = (M != nullptr) ? ws[7] : s;
+
+    Vector x(n);
+    double bb = 0.0;
+    double rr = 0.0, rr_new = 0.0;
+    double rho = 0.0, rho_new = 0.0;
+    double r0v = 0.0, ss = 0.0, ts = 0.0, tt = 0.0;
+    int iter = 0;
+
+    #pragma omp parallel num_threads(n_threads)
+    {
+        #pragma omp for reduction(+:bb) schedule(static)
+        for (int i = 0; i < n; ++i)
+        {
+            x[i] = 0.0;
+            r[i] = b[i];
+            r0[i] = b[i];
+            p[i] = 0.0;
+            v[i] = 0.0;
+            bb += b[i] * b[i];
+        }
+
+        #pragma omp single
+        {
+            rr = bb;
+            rho = bb;
+        }
+
+        const int parts = omp_get_num_threads();
+        double rho_old = 1.0, alpha = 1.0, omega = 1.0;
+        while (sqrt(rr / bb) >= epsilon && iter < KRYLOV_MAX_ITERATIONS && rho != 0.0)
+        {
+            const double beta = (rho / rho_old) * (alpha / omega);
+
+            #pragma omp for schedule(static)
+            for (int i = 0; i < n; ++i)
+            {
+                p[i] = r[i] + beta * (p[i] - omega * v[i]);
+            }
+
+            if (M != nullptr)
+            {
+                M->apply(p, ph);
+            }
+
+            #pragma omp for reduction(+:r0v) schedule(static, 1)
+            for (int part = 0; part < parts; ++part)
+            {
+                const int end = rowBegin(A, part + 1, parts);
+                for (int i = rowBegin(A, part, parts); i < end; ++i)
+                {
+                    v[i] = rowDot(A, i, ph);
+                    r0v += r0[i] * v[i];
+                }
+            }
+            if (r0v == 0.0)
+                break;
+            alpha = rho / r0v;
+
+            #pragma omp for reduction(+:ss) schedule(static)
+            for (int i = 0; i < n; ++i)
+            {
+                s[i] = r[i] - alpha * v[i];
+                ss += s[i] * s[i];
+            }
+
+            if (sqrt(ss / bb) < epsilon)
+            {
+                #pragma omp for schedule(static)
+                for (int i = 0; i < n; ++i)
+                {
+                    x[i] += alpha * ph[i];
+                }
+                #pragma omp single
+                {
+                    rr = ss;
+                    ++iter;
+                }
+                break;
+            }
+
+            if (M != nullptr)
+            {
+                M->apply(s, sh);
+            }
+
+            #pragma omp for reduction(+:ts, tt) schedule(static, 1)
+            for (int part = 0; part < parts; ++part)
+            {
+                const int end = rowBegin(A, part + 1, parts);
+                for (int i = rowBegin(A, part, parts); i < end; ++i)
+                {
+                    t[i] = rowDot(A, i, sh);
+                    ts += t[i] * s[i];
+                    tt += t[i] * t[i];
+                }
+            }
+            if (tt == 0.0)
+                break;
+            omega = ts / tt;
+            rho_old = rho;
+
+            #pragma omp for reduction(+:rr_new, rho_new) schedule(static)
+            for (int i = 0; i < n; ++i)
+            {
+                x[i] += alpha * ph[i] + omega * sh[i];
+                r[i] = s[i] - omega * t[i];
+                rr_new += r[i] * r[i];
+                rho_new += r0[i] * r[i];
+            }
+
+            // every thread has read rho, r0v, ss, ts and tt by now (barrier after the loop above)
+            #pragma omp single
+            {
+                rr = rr_new;
+                rho = rho_new;
+                rr_new = rho_new = 0.0;
+                r0v = ss = ts = tt = 0.0;
+                ++iter;
+            }
+        }
+    }
+
+    if (iterations != nullptr)
+    {
+        *iterations = iter;
+    }
+    return x;
+}
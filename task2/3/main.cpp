@@ -4,14 +4,13 @@
 #include <time.h>
 #include <omp.h>
 
+#include "matrix.hpp"
+
 using namespace std;
 
 const double EPSILON = 1e-5;
 const double TAU = 0.000001; // 0.000001 and 10 000 for Execution time (serial): 173.691134
 
-using Vector = vector<double>;
-using Matrix = vector<Vector>;
-
 double norm(const Vector &v)
 {
     double sum = 0.0;
@@ -66,7 +65,7 @@ Vector simpleIterationMethod(const Matrix &A, const Vector &b)
 
 void initializeSystem(Matrix &A, Vector &b, int N)
 {
-    A.assign(N, Vector(N, 1.0));
+    A.assign(N, 1.0);
     for (int i = 0; i < N; ++i)
     {
         A[i][i] = 2.0;
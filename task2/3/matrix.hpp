@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+#include <omp.h>
+
+#define MATRIX_ALIGNMENT 64 // cache line size
+
+using Vector = std::vector<double>;
+using FloatVector = std::vector<float>;
+
+// Allocator that returns MATRIX_ALIGNMENT-aligned memory, so that std::vector can own the matrix storage.
+// resize() leaves elements uninitialized, the matrix is then filled in parallel (see Matrix::assign).
+template <typename T>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U> &) {}
+
+    T *allocate(size_t n)
+    {
+        size_t bytes = (n * sizeof(T) + MATRIX_ALIGNMENT - 1) / MATRIX_ALIGNMENT * MATRIX_ALIGNMENT;
+        void *p = aligned_alloc(MATRIX_ALIGNMENT, bytes);
+        if (p == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T *>(p);
+    }
+
+    void deallocate(T *p, size_t) { free(p); }
+
+    template <typename U>
+    void construct(U *) {}
+    template <typename U, typename... Args>
+    void construct(U *p, Args &&...args) { ::new ((void *)p) U(std::forward<Args>(args)...); }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U> &) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U> &) const { return false; }
+};
+
+// Square matrix stored in one contiguous row-major block. The row stride is padded
+// to a whole number of cache lines so every row starts 64-byte aligned.
+// A[i] is a pointer to row i, so A[i][j] works as with vector<vector<double>>.
+// Matrix holds doubles; FloatMatrix is the single precision copy used by mixed.hpp.
+template <typename T>
+class BasicMatrix
+{
+public:
+    BasicMatrix() : n(0), ld(0) {}
+
+    BasicMatrix(int size, T value) { assign(size, value); }
+
+    // Rows are filled by a static parallel loop: with first-touch page placement each
+    // row then lives on the NUMA node of the thread that will later process it.
+    void assign(int size, T value)
+    {
+        const size_t per_line = MATRIX_ALIGNMENT / sizeof(T);
+        n = size;
+        ld = (n + per_line - 1) / per_line * per_line;
+        storage = std::vector<T, AlignedAllocator<T>>();
+        storage.resize((size_t)n * ld);
+        T *p = storage.data();
+
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < n; ++i)
+        {
+            for (size_t j = 0; j < ld; ++j)
+            {
+                p[(size_t)i * ld + j] = (j < (size_t)n) ? value : T(0);
+            }
+        }
+    }
+
+    int size() const { return n; }
+    size_t stride() const { return ld; }
+
+    T *operator[](int i) { return storage.data() + (size_t)i * ld; }
+    const T *operator[](int i) const { return storage.data() + (size_t)i * ld; }
+
+    T *data() { return storage.data(); }
+    const T *data() const { return storage.data(); }
+
+private:
+    int n;
+    size_t ld;
+    std::vector<T, AlignedAllocator<T>> storage;
+};
+
+using Matrix = BasicMatrix<double>;
+using FloatMatrix = BasicMatrix<float>;
+
+// (A x)_i. Solvers access operators only through rowDot and A.size(), so other
+// matrix formats plug in by providing an overload.
+inline double rowDot(const Matrix &A, int i, const double *x)
+{
+    const double *row = A[i];
+    int n = A.size();
+    double sum = 0.0;
+    for (int j = 0; j < n; ++j)
+    {
+        sum += row[j] * x[j];
+    }
+    return sum;
+}
+
+// First row of part `part` when the rows are cut into `parts` pieces of equal work.
+// Matrix-vector loops run over omp_get_num_threads() parts, one per thread; for a
+// dense matrix that is the same as a static schedule, sparse formats overload it to
+// balance nonzeros instead of rows.
+inline int rowBegin(const Matrix &A, int part, int parts)
+{
+    return (int)((long long)A.size() * part / parts);
+}
+
+// Single precision (A x)_i. Only used inside refinement loops whose result is corrected
+// in double, so the summation order is left to the compiler and the loop vectorizes.
+inline float rowDot(const FloatMatrix &A, int i, const float *x)
+{
+    const float *row = A[i];
+    int n = A.size();
+    float sum = 0.0f;
+    #pragma omp simd reduction(+:sum)
+    for (int j = 0; j < n; ++j)
+    {
+        sum += row[j] * x[j];
+    }
+    return sum;
+}
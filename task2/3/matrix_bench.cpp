@@ -0,0 +1,81 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <time.h>
+#include <omp.h>
+
+#include "matrix.hpp"
+
+#define N_THREADS 8
+#define N 5000
+#define ITERATIONS 100
+
+using namespace std;
+
+const double TAU = 0.000001;
+
+using NestedMatrix = vector<Vector>;
+
+// One step of the simple iteration as in task31: Ax = A * x, x -= TAU * (Ax - b).
+// Templated so the same loop runs on both storage layouts.
+template <typename M>
+double iterate(const M &A, const Vector &b, int n, int n_threads)
+{
+    Vector x(n, 0.0);
+    Vector Ax(n);
+
+    double t = omp_get_wtime();
+    for (int it = 0; it < ITERATIONS; ++it)
+    {
+        #pragma omp parallel for num_threads(n_threads)
+        for (int i = 0; i < n; ++i)
+        {
+            double sum = 0.0;
+            for (int j = 0; j < n; ++j)
+            {
+                sum += A[i][j] * x[j];
+            }
+            Ax[i] = sum;
+        }
+
+        #pragma omp parallel for num_threads(n_threads)
+        for (int i = 0; i < n; ++i)
+        {
+            x[i] -= TAU * (Ax[i] - b[i]);
+        }
+    }
+    return (omp_get_wtime() - t) / ITERATIONS;
+}
+
+int main()
+{
+    Vector b(N, N + 1);
+
+    double t = omp_get_wtime();
+    NestedMatrix nested(N, Vector(N, 1.0));
+    for (int i = 0; i < N; ++i)
+    {
+        nested[i][i] = 2.0;
+    }
+    double setup_nested = omp_get_wtime() - t;
+
+    t = omp_get_wtime();
+    Matrix contiguous(N, 1.0);
+    for (int i = 0; i < N; ++i)
+    {
+        contiguous[i][i] = 2.0;
+    }
+    double setup_contiguous = omp_get_wtime() - t;
+
+    double iter_nested = iterate(nested, b, N, N_THREADS);
+    double iter_contiguous = iterate(contiguous, b, N, N_THREADS);
+
+    printf("N: %d | Threads: %d\n", N, N_THREADS);
+    printf("Setup (vector<vector>): %.6f sec | Setup (Matrix): %.6f sec | Speedup: %.2f\n",
+           setup_nested, setup_contiguous, setup_nested / setup_contiguous);
+    printf("Iteration (vector<vector>): %.6f sec | Iteration (Matrix): %.6f sec | Speedup: %.2f\n",
+           iter_nested, iter_contiguous, iter_nested / iter_contiguous);
+
+    return 0;
+}
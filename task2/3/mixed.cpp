@@ -0,0 +1,87 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <time.h>
+#include <omp.h>
+
+#include "matrix.hpp"
+#include "iteration.hpp"
+#include "mixed.hpp"
+
+#define N_THREADS 8
+
+using namespace std;
+
+const double EPSILON = 1e-5;
+const double TAU = 0.000001;
+
+double relativeResidual(const Matrix &A, const Vector &b, const Vector &x)
+{
+    double rr = 0.0, bb = 0.0;
+    for (int i = 0; i < A.size(); ++i)
+    {
+        double r = rowDot(A, i, x.data()) - b[i];
+        rr += r * r;
+        bb += b[i] * b[i];
+    }
+    return sqrt(rr / bb);
+}
+
+int main()
+{
+    int N;
+    cout << "Enter the number of equations (N = 5000 as an example): ";
+    cin >> N;
+
+    if (N <= 0)
+    {
+        cout << "Error: N must be greater than 0" << endl;
+        return 1;
+    }
+
+    Matrix A(N, 1.0);
+    Vector b(N, N + 1);
+    for (int i = 0; i < N; ++i)
+    {
+        A[i][i] = 2.0;
+    }
+
+    int iterations;
+    double t = omp_get_wtime();
+    Vector x_double = simpleIterationMethodFused(A, b, TAU, EPSILON, N_THREADS, &iterations);
+    double t_double = omp_get_wtime() - t;
+
+    t = omp_get_wtime();
+    FloatMatrix Af = toFloat(A, N_THREADS);
+    double t_convert = omp_get_wtime() - t;
+
+    RefinementStats stats;
+    t = omp_get_wtime();
+    Vector x_mixed = mixedPrecisionRefinement(A, Af, b, TAU, EPSILON, N_THREADS, &stats);
+    double t_mixed = omp_get_wtime() - t;
+
+    // bytes of the matrix streamed per solve: one pass per iteration, plus for the mixed
+    // solver the double residual passes (one more than the corrections) and the conversion
+    double double_bytes = (double)iterations * N * A.stride() * sizeof(double);
+    double mixed_bytes = (double)stats.inner * N * Af.stride() * sizeof(float) +
+                         (double)(stats.outer + 1) * N * A.stride() * sizeof(double);
+    double convert_bytes = (double)N * (A.stride() * sizeof(double) + Af.stride() * sizeof(float));
+
+    printf("All double: %d iterations, %.6f sec, residual %.2e, matrix traffic %.2f GB\n",
+           iterations, t_double, relativeResidual(A, b, x_double), double_bytes / 1e9);
+    printf("Mixed: %d float iterations + %d corrections, %.6f sec (+%.6f sec conversion), residual %.2e, matrix traffic %.2f GB (+%.2f GB conversion)\n",
+           stats.inner, stats.outer, t_mixed, t_convert, relativeResidual(A, b, x_mixed), mixed_bytes / 1e9,
+           convert_bytes / 1e9);
+    printf("Traffic saved: %.1f%% | Speedup: %.2f (%.2f including conversion)\n",
+           100.0 * (1.0 - (mixed_bytes + convert_bytes) / double_bytes), t_double / t_mixed,
+           t_double / (t_mixed + t_convert));
+
+    std::ofstream out("Out_mixed.txt");
+    out << "# method  iterations  time  matrix_bytes\n";
+    out << "double\t" << iterations << "\t" << t_double << "\t" << double_bytes << "\n";
+    out << "mixed\t" << stats.inner << "\t" << t_mixed + t_convert << "\t" << mixed_bytes + convert_bytes << "\n";
+    out.close();
+    cout << "File has been written" << std::endl;
+    return 0;
+}
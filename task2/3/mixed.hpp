@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <omp.h>
+
+#include "matrix.hpp"
+
+#define INNER_REDUCTION 1e-2 // the float solve stops once its residual has dropped by this factor
+#define REFINE_MARGIN 0.5     // ... or once the outer residual would be below REFINE_MARGIN * epsilon
+#define REFINE_MAX_OUTER 50   // refinement steps before giving up (float solve not accurate enough)
+
+struct RefinementStats
+{
+    int outer = 0; // double precision residual passes that led to a correction
+    int inner = 0; // float iterations over all corrections
+};
+
+// Float copy of A. Same static row distribution as Matrix::assign, so every row of
+// the copy is first touched by the thread that touched the original row.
+inline FloatMatrix toFloat(const Matrix &A, int n_threads)
+{
+    int n = A.size();
+    FloatMatrix Af;
+    Af.assign(n, 0.0f);
+
+    #pragma omp parallel for schedule(static) num_threads(n_threads)
+    for (int i = 0; i < n; ++i)
+    {
+        const double *src = A[i];
+        float *dst = Af[i];
+        for (int j = 0; j < n; ++j)
+        {
+            dst[j] = (float)src[j];
+        }
+    }
+    return Af;
+}
+
+// Mixed precision iterative refinement around the simple iteration:
+//   r = b - A x                      in double, on A
+//   A d = r / ||r||  approximately   in float, on Af, simple iteration until ||A d - r/||r|| || < tol
+//   x += ||r|| d                     in double
+// The float solve streams half the bytes of A per iteration; the double residual pass
+// keeps the final accuracy independent of float rounding. The right-hand side of the
+// float solve is normalized, so the corrections never run into float range limits.
+// tol is INNER_REDUCTION, relaxed on the last step to what is still missing to reach
+// epsilon (with REFINE_MARGIN to spare), so the solve does not overshoot the target.
+// No preconditioner: the inner solve runs on float vectors, Preconditioner::apply on double.
+inline Vector mixedPrecisionRefinement(const Matrix &A, const FloatMatrix &Af, const Vector &b, double tau,
+                                       double epsilon, int n_threads, RefinementStats *stats = nullptr)
+{
+    int n = A.size();
+    Vector x(n, 0.0);
+    Vector r(n);
+    FloatVector rf(n), d(n), d_next(n);
+    const float tau_f = (float)tau;
+    double b_norm2 = 0.0;
+    double r_norm2 = 0.0;
+    float inner_norm2 = 0.0f;
+    int outer = 0;
+    int inner = 0;
+    bool stop = false;
+
+    #pragma omp parallel num_threads(n_threads)
+    {
+        #pragma omp for reduction(+:b_norm2)
+        for (int i = 0; i < n; ++i)
+        {
+            b_norm2 += b[i] * b[i];
+        }
+
+        while (true)
+        {
+            #pragma omp for reduction(+:r_norm2) schedule(static)
+            for (int i = 0; i < n; ++i)
+            {
+                r[i] = b[i] - rowDot(A, i, x.data());
+                r_norm2 += r[i] * r[i];
+            }
+
+            const double r_norm = sqrt(r_norm2);
+            if (r_norm / sqrt(b_norm2) < epsilon || outer == REFINE_MAX_OUTER)
+                break;
+            const float tol = (float)std::max(INNER_REDUCTION, REFINE_MARGIN * epsilon * sqrt(b_norm2) / r_norm);
+
+            #pragma omp for schedule(static)
+            for (int i = 0; i < n; ++i)
+            {
+                rf[i] = (float)(r[i] / r_norm);
+                d[i] = 0.0f;
+            }
+
+            // float simple iteration on A d = rf, fused as in simpleIterationMethodFused
+            while (true)
+            {
+                const float *dp = d.data();
+                float *dn = d_next.data();
+
+                #pragma omp for reduction(+:inner_norm2) schedule(static)
+                for (int i = 0; i < n; ++i)
+                {
+                    float ri = rowDot(Af, i, dp) - rf[i];
+                    inner_norm2 += ri * ri;
+                    dn[i] = dp[i] - tau_f * ri;
+                }
+
+                #pragma omp single
+                {
+                    if (sqrtf(inner_norm2) < tol)
+                    {
+                        stop = true;
+                    }
+                    else
+                    {
+                        d.swap(d_next);
+                        ++inner;
+                    }
+                    inner_norm2 = 0.0f;
+                }
+
+                if (stop)
+                    break;
+            }
+
+            #pragma omp for schedule(static)
+            for (int i = 0; i < n; ++i)
+            {
+                x[i] += r_norm * d[i];
+            }
+
+            // everybody has read r_norm2 and stop (barrier after the loop above)
+            #pragma omp single
+            {
+                r_norm2 = 0.0;
+                stop = false;
+                ++outer;
+            }
+        }
+    }
+
+    if (stats != nullptr)
+    {
+        stats->outer = outer;
+        stats->inner = inner;
+    }
+    return x;
+}
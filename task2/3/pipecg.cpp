@@ -0,0 +1,111 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <time.h>
+#include <omp.h>
+
+#include "matrix.hpp"
+#include "cg.hpp"
+
+#define BARRIER_REPEATS 10000
+#define CG_BARRIERS 4   // per iteration: three loops and the single
+#define PIPE_BARRIERS 2 // per iteration: two loops
+
+using namespace std;
+
+const double EPSILON = 1e-5;
+
+// Same system as precond.cpp: the task matrix I + 11^T lets CG stop after one
+// iteration, so A = S K S, K_ij = exp(-|i - j| / 4), S = diag(1, 12, .., 100) repeated, b = 1.
+void initializeScaledKernelSystem(Matrix &A, Vector &b, int N)
+{
+    A.assign(N, 0.0);
+    #pragma omp parallel for
+    for (int i = 0; i < N; ++i)
+    {
+        double si = 1.0 + 11.0 * (i % 10);
+        for (int j = 0; j < N; ++j)
+        {
+            double sj = 1.0 + 11.0 * (j % 10);
+            A[i][j] = si * sj * exp(-fabs(i - j) / 4.0);
+        }
+    }
+    b.assign(N, 1.0);
+}
+
+double relativeResidual(const Matrix &A, const Vector &b, const Vector &x)
+{
+    double rr = 0.0, bb = 0.0;
+    for (int i = 0; i < A.size(); ++i)
+    {
+        double r = rowDot(A, i, x.data()) - b[i];
+        rr += r * r;
+        bb += b[i] * b[i];
+    }
+    return sqrt(rr / bb);
+}
+
+// Average cost of one omp barrier for a team of n_threads
+double barrierCost(int n_threads)
+{
+    double t = omp_get_wtime();
+    #pragma omp parallel num_threads(n_threads)
+    for (int k = 0; k < BARRIER_REPEATS; ++k)
+    {
+        #pragma omp barrier
+    }
+    return (omp_get_wtime() - t) / BARRIER_REPEATS;
+}
+
+int main()
+{
+    int N;
+    cout << "Enter the number of equations (N = 2000 as an example): ";
+    cin >> N;
+
+    if (N <= 0)
+    {
+        cout << "Error: N must be greater than 0" << endl;
+        return 1;
+    }
+
+    Matrix A;
+    Vector b;
+    initializeScaledKernelSystem(A, b, N);
+
+    std::ofstream out("Out_pipecg.txt");
+    out << "# threads  cg_time  pipelined_time  barrier_cost  sync_saved_estimate\n";
+
+    vector<int> thread_counts = {1, 2, 4, 8, 16, 20, 40, 80};
+    for (int n_threads : thread_counts)
+    {
+        if (n_threads > N)
+            break;
+
+        int it_cg, it_pipe;
+        double t = omp_get_wtime();
+        Vector x_cg = conjugateGradientMethod(A, b, EPSILON, n_threads, &it_cg);
+        double t_cg = omp_get_wtime() - t;
+
+        t = omp_get_wtime();
+        Vector x_pipe = pipelinedConjugateGradientMethod(A, b, EPSILON, n_threads, &it_pipe);
+        double t_pipe = omp_get_wtime() - t;
+
+        // An estimate, not a measurement: barriers saved times what an empty barrier costs
+        // with this team. The real difference also depends on imbalance and on the extra
+        // vector updates of the pipelined recurrences, so it can be negative.
+        double barrier = barrierCost(n_threads);
+        double saved = (double)(CG_BARRIERS * it_cg - PIPE_BARRIERS * it_pipe) * barrier;
+
+        printf("threads %2d | CG: %d it, %.6f sec, residual %.2e | pipelined: %d it, %.6f sec, residual %.2e | "
+               "barrier %.2f us, sync saved (estimate) ~%.6f sec | Speedup: %.2f\n",
+               n_threads, it_cg, t_cg, relativeResidual(A, b, x_cg), it_pipe, t_pipe,
+               relativeResidual(A, b, x_pipe), barrier * 1e6, saved, t_cg / t_pipe);
+        out << n_threads << "\t" << t_cg << "\t" << t_pipe << "\t" << barrier << "\t" << saved << "\n";
+    }
+
+    out.close();
+    cout << "File has been written" << std::endl;
+    return 0;
+}
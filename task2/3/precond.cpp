@@ -0,0 +1,159 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <time.h>
+#include <omp.h>
+
+#include "matrix.hpp"
+#include "preconditioner.hpp"
+#include "cg.hpp"
+#include "chebyshev.hpp"
+#include "krylov.hpp"
+
+#define N_THREADS 8
+#define APPLY_REPEATS 20
+#define RESTART 30
+
+using namespace std;
+
+const double EPSILON = 1e-5;
+
+// The task matrix I + 11^T has only two distinct eigenvalues, so CG needs at most two
+// iterations with or without preconditioning. To see a difference the benchmark uses a
+// badly scaled SPD matrix instead: A = S K S, K_ij = exp(-|i - j| / 4), S = diag(1 .. 100).
+void initializeScaledKernelSystem(Matrix &A, Vector &b, int N)
+{
+    A.assign(N, 0.0);
+    #pragma omp parallel for num_threads(N_THREADS)
+    for (int i = 0; i < N; ++i)
+    {
+        double si = 1.0 + 99.0 * (i % 10) / 9.0;
+        for (int j = 0; j < N; ++j)
+        {
+            double sj = 1.0 + 99.0 * (j % 10) / 9.0;
+            A[i][j] = si * sj * exp(-fabs(i - j) / 4.0);
+        }
+    }
+    b.assign(N, 1.0);
+}
+
+double relativeResidual(const Matrix &A, const Vector &b, const Vector &x)
+{
+    double rr = 0.0, bb = 0.0;
+    for (int i = 0; i < A.size(); ++i)
+    {
+        double r = rowDot(A, i, x.data()) - b[i];
+        rr += r * r;
+        bb += b[i] * b[i];
+    }
+    return sqrt(rr / bb);
+}
+
+double applyTime(const Preconditioner &M, const Vector &r)
+{
+    Vector z(r.size());
+    double t = omp_get_wtime();
+    #pragma omp parallel num_threads(N_THREADS)
+    for (int k = 0; k < APPLY_REPEATS; ++k)
+    {
+        M.apply(r.data(), z.data());
+    }
+    return (omp_get_wtime() - t) / APPLY_REPEATS;
+}
+
+enum class Solver
+{
+    CG,
+    Chebyshev,
+    GMRES,
+    BiCGSTAB
+};
+
+const char *solverName(Solver solver)
+{
+    switch (solver)
+    {
+    case Solver::CG:
+        return "CG";
+    case Solver::Chebyshev:
+        return "Chebyshev";
+    case Solver::GMRES:
+        return "GMRES";
+    default:
+        return "BiCGSTAB";
+    }
+}
+
+// Chebyshev's spectrum estimate (of M^{-1} A) is counted as part of its solve
+Vector solve(Solver solver, const Matrix &A, const Vector &b, const Preconditioner *M, int *iter)
+{
+    switch (solver)
+    {
+    case Solver::CG:
+        return conjugateGradientMethod(A, b, EPSILON, N_THREADS, iter, M);
+    case Solver::Chebyshev:
+    {
+        double lambda_min, lambda_max;
+        estimateSpectrum(A, N_THREADS, &lambda_min, &lambda_max, M);
+        return chebyshevIterationMethod(A, b, lambda_min, lambda_max, EPSILON, N_THREADS, iter, M);
+    }
+    case Solver::GMRES:
+        return gmresMethod(A, b, RESTART, EPSILON, N_THREADS, iter, nullptr, M);
+    default:
+        return biCGStabMethod(A, b, EPSILON, N_THREADS, iter, nullptr, M);
+    }
+}
+
+void run(const char *name, const Matrix &A, const Vector &b, const Preconditioner *M, double t_setup)
+{
+    const Solver solvers[] = {Solver::CG, Solver::Chebyshev, Solver::GMRES, Solver::BiCGSTAB};
+    double t_apply = (M != nullptr) ? applyTime(*M, b) : 0.0;
+    printf("%-8s | setup %.6f sec | apply %.6f sec\n", name, t_setup, t_apply);
+
+    for (Solver solver : solvers)
+    {
+        // unpreconditioned, Chebyshev and GMRES(30) need tens of thousands of iterations here
+        if (M == nullptr && (solver == Solver::Chebyshev || solver == Solver::GMRES))
+            continue;
+        int iter;
+        double t = omp_get_wtime();
+        Vector x = solve(solver, A, b, M, &iter);
+        t = omp_get_wtime() - t;
+        printf("  %-9s | %5d it | solve %.6f sec (%.6f sec/it) | total %.6f sec | residual %.2e\n",
+               solverName(solver), iter, t, t / (iter > 0 ? iter : 1), t_setup + t, relativeResidual(A, b, x));
+    }
+}
+
+int main()
+{
+    int N;
+    cout << "Enter the number of equations (N = 2000 as an example): ";
+    cin >> N;
+
+    if (N <= 0)
+    {
+        cout << "Error: N must be greater than 0" << endl;
+        return 1;
+    }
+
+    Matrix A;
+    Vector b;
+    initializeScaledKernelSystem(A, b, N);
+
+    run("none", A, b, nullptr, 0.0);
+
+    double t = omp_get_wtime();
+    JacobiPreconditioner jacobi(A, N_THREADS);
+    run(jacobi.name(), A, b, &jacobi, omp_get_wtime() - t);
+
+    t = omp_get_wtime();
+    SsorPreconditioner ssor(A, 1.2, N_THREADS);
+    run(ssor.name(), A, b, &ssor, omp_get_wtime() - t);
+
+    t = omp_get_wtime();
+    IncompleteCholeskyPreconditioner ic(A, N_THREADS);
+    run(ic.name(), A, b, &ic, omp_get_wtime() - t);
+
+    return 0;
+}
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <cmath>
+#include <omp.h>
+
+#include "matrix.hpp"
+
+#define TRI_BLOCK 256 // rows per block in the blocked triangular solves
+
+// z = M^{-1} r. apply() must be called by all threads of an enclosing parallel
+// region (it is made of orphaned omp for / single constructs), so a solver can use
+// it inside its own parallel region. All setup work happens in the constructors.
+// Taken by conjugateGradientMethod, chebyshevIterationMethod (and estimateSpectrum),
+// gmresMethod and biCGStabMethod. The simple iteration, its block and mixed precision
+// variants and pipelinedConjugateGradientMethod have no hook: the block solver keeps k
+// vectors interleaved and the mixed one runs in float, neither matches apply().
+class Preconditioner
+{
+public:
+    virtual ~Preconditioner() = default;
+    virtual const char *name() const = 0;
+    virtual void apply(const double *r, double *z) const = 0;
+};
+
+// Solve (lower part of M + diag) y = r, the strictly lower part read from M and the
+// diagonal from diag. Rows are processed in blocks of TRI_BLOCK: the product with the
+// already solved part is spread over the threads, the small triangle inside the block
+// is solved by one thread.
+inline void forwardSolve(const Matrix &M, const double *diag, const double *r, double *y)
+{
+    int n = M.size();
+    for (int lb = 0; lb < n; lb += TRI_BLOCK)
+    {
+        int ub = (lb + TRI_BLOCK < n) ? lb + TRI_BLOCK : n;
+
+        #pragma omp for schedule(static)
+        for (int i = lb; i < ub; ++i)
+        {
+            const double *row = M[i];
+            double sum = r[i];
+            for (int j = 0; j < lb; ++j)
+            {
+                sum -= row[j] * y[j];
+            }
+            y[i] = sum;
+        }
+
+        #pragma omp single
+        for (int i = lb; i < ub; ++i)
+        {
+            const double *row = M[i];
+            double sum = y[i];
+            for (int j = lb; j < i; ++j)
+            {
+                sum -= row[j] * y[j];
+            }
+            y[i] = sum / diag[i];
+        }
+    }
+}
+
+// Solve (upper part of M + diag) z = y, mirror image of forwardSolve.
+inline void backwardSolve(const Matrix &M, const double *diag, const double *y, double *z)
+{
+    int n = M.size();
+    for (int ub = n; ub > 0; ub -= TRI_BLOCK)
+    {
+        int lb = (ub - TRI_BLOCK > 0) ? ub - TRI_BLOCK : 0;
+
+        #pragma omp for schedule(static)
+        for (int i = lb; i < ub; ++i)
+        {
+            const double *row = M[i];
+            double sum = y[i];
+            for (int j = ub; j < n; ++j)
+            {
+                sum -= row[j] * z[j];
+            }
+            z[i] = sum;
+        }
+
+        #pragma omp single
+        for (int i = ub - 1; i >= lb; --i)
+        {
+            const double *row = M[i];
+            double sum = z[i];
+            for (int j = i + 1; j < ub; ++j)
+            {
+                sum -= row[j] * z[j];
+            }
+            z[i] = sum / diag[i];
+        }
+    }
+}
+
+// M = diag(A)
+class JacobiPreconditioner : public Preconditioner
+{
+public:
+    JacobiPreconditioner(const Matrix &A, int n_threads) : inv_diag(A.size())
+    {
+        int n = A.size();
+        #pragma omp parallel for num_threads(n_threads)
+        for (int i = 0; i < n; ++i)
+        {
+            inv_diag[i] = 1.0 / A[i][i];
+        }
+    }
+
+    const char *name() const override { return "Jacobi"; }
+
+    void apply(const double *r, double *z) const override
+    {
+        int n = inv_diag.size();
+        #pragma omp for schedule(static)
+        for (int i = 0; i < n; ++i)
+        {
+            z[i] = inv_diag[i] * r[i];
+        }
+    }
+
+private:
+    Vector inv_diag;
+};
+
+// Symmetric SOR for symmetric A = L + D + L^T:
+// M = omega / (2 - omega) * (D / omega + L) (D / omega)^{-1} (D / omega + L^T).
+// Works on A directly, the setup only collects the scaled diagonal.
+class SsorPreconditioner : public Preconditioner
+{
+public:
+    SsorPreconditioner(const Matrix &A, double omega, int n_threads)
+        : A(A), omega(omega), diag(A.size()), work(A.size())
+    {
+        int n = A.size();
+        #pragma omp parallel for num_threads(n_threads)
+        for (int i = 0; i < n; ++i)
+        {
+            diag[i] = A[i][i] / omega;
+        }
+    }
+
+    const char *name() const override { return "SSOR"; }
+
+    void apply(const double *r, double *z) const override
+    {
+        int n = A.size();
+        double *y = work.data();
+        forwardSolve(A, diag.data(), r, y);
+
+        const double scale = (2.0 - omega) / omega;
+        #pragma omp for schedule(static)
+        for (int i = 0; i < n; ++i)
+        {
+            y[i] *= scale * diag[i];
+        }
+
+        backwardSolve(A, diag.data(), y, z);
+    }
+
+private:
+    const Matrix &A;
+    double omega;
+    Vector diag;
+    mutable Vector work;
+};
+
+// Incomplete Cholesky with zero fill-in: L L^T ~ A, where L keeps the sparsity
+// pattern of the lower triangle of A. For a dense A that is the full Cholesky factor.
+// L and L^T share one matrix F: F[i][j] = L_ij for j < i and F[i][j] = L_ji for j > i,
+// so both triangular solves read F row by row.
+class IncompleteCholeskyPreconditioner : public Preconditioner
+{
+public:
+    IncompleteCholeskyPreconditioner(const Matrix &A, int n_threads)
+        : F(A), diag(A.size()), work(A.size())
+    {
+        int n = A.size();
+
+        // right-looking factorization of the lower triangle, in place; updates only
+        // touch entries that are nonzero in A
+        #pragma omp parallel num_threads(n_threads)
+        for (int k = 0; k < n; ++k)
+        {
+            #pragma omp single
+            {
+                double pivot = F[k][k];
+                // breakdown (possible when entries are dropped): fall back to the original diagonal
+                diag[k] = (pivot > 0.0) ? sqrt(pivot) : sqrt(fabs(A[k][k]));
+            }
+
+            const double lkk = diag[k];
+            #pragma omp for schedule(static)
+            for (int i = k + 1; i < n; ++i)
+            {
+                F[i][k] /= lkk;
+            }
+
+            #pragma omp for schedule(dynamic, 16)
+            for (int i = k + 1; i < n; ++i)
+            {
+                double *row = F[i];
+                const double lik = row[k];
+                if (lik == 0.0)
+                    continue;
+                for (int j = k + 1; j <= i; ++j)
+                {
+                    if (A[i][j] != 0.0)
+                    {
+                        row[j] -= lik * F[j][k];
+                    }
+                }
+            }
+        }
+
+        // mirror L into the upper triangle
+        #pragma omp parallel for num_threads(n_threads) schedule(dynamic, 16)
+        for (int i = 0; i < n; ++i)
+        {
+            F[i][i] = diag[i];
+            for (int j = i + 1; j < n; ++j)
+            {
+                F[i][j] = F[j][i];
+            }
+        }
+    }
+
+    const char *name() const override { return "IC(0)"; }
+
+    void apply(const double *r, double *z) const override
+    {
+        forwardSolve(F, diag.data(), r, work.data());
+        backwardSolve(F, diag.data(), work.data(), z);
+    }
+
+private:
+    Matrix F;
+    Vector diag;
+    mutable Vector work;
+};
@@ -0,0 +1,209 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <time.h>
+#include <omp.h>
+
+#include "matrix.hpp"
+#include "csr.hpp"
+#include "iteration.hpp"
+#include "cg.hpp"
+#include "chebyshev.hpp"
+#include "krylov.hpp"
+
+#define N_THREADS 8
+#define RESTART 30
+#define ARROW_STRIDE 4 // the generated matrix couples node 0 with every ARROW_STRIDE-th node
+
+using namespace std;
+
+const double EPSILON = 1e-5;
+const char *GENERATED = "sparse_test.mtx";
+
+double relativeResidual(const CsrMatrix &A, const Vector &b, const Vector &x)
+{
+    double rr = 0.0, bb = 0.0;
+    for (int i = 0; i < A.size(); ++i)
+    {
+        double r = rowDot(A, i, x.data()) - b[i];
+        rr += r * r;
+        bb += b[i] * b[i];
+    }
+    return sqrt(rr / bb);
+}
+
+// 5-point Laplacian on a G x G grid plus an "arrow": node 0 coupled to every
+// ARROW_STRIDE-th node, with the diagonal raised to keep the matrix SPD. Row 0 then has
+// about n / ARROW_STRIDE nonzeros, the other rows at most 6, which is what the
+// nonzero-balanced partition is for. Written as a symmetric file, lower triangle only.
+void writeTestMatrix(const char *path, int G)
+{
+    int n = G * G;
+    vector<string> lines;
+    for (int i = 0; i < n; ++i)
+    {
+        int gx = i % G, gy = i / G;
+        double diag = 4.0;
+        if (i > 0 && i % ARROW_STRIDE == 0)
+        {
+            lines.push_back(to_string(i + 1) + " 1 -0.001");
+            diag += 0.001;
+        }
+        if (gx > 0)
+            lines.push_back(to_string(i + 1) + " " + to_string(i) + " -1");
+        if (gy > 0)
+            lines.push_back(to_string(i + 1) + " " + to_string(i - G + 1) + " -1");
+        if (i == 0)
+            diag += 0.001 * ((n - 1) / ARROW_STRIDE);
+        ostringstream d;
+        d << i + 1 << " " << i + 1 << " " << diag;
+        lines.push_back(d.str());
+    }
+    ofstream out(path);
+    out << "%%MatrixMarket matrix coordinate real symmetric\n% generated by sparse.cpp\n";
+    out << n << " " << n << " " << lines.size() << "\n";
+    for (const string &line : lines)
+    {
+        out << line << "\n";
+    }
+}
+
+// Reference reader: istream, one thread, same result
+bool loadMatrixMarketStream(const string &path, CsrMatrix &A)
+{
+    ifstream in(path);
+    string line;
+    getline(in, line);
+    bool symmetric = line.find("symmetric") != string::npos;
+    while (in.peek() == '%')
+        getline(in, line);
+    int rows, cols;
+    size_t m;
+    if (!(in >> rows >> cols >> m))
+        return false;
+    vector<MatrixMarketEntry> e(m);
+    for (size_t k = 0; k < m; ++k)
+    {
+        in >> e[k].row >> e[k].col >> e[k].val;
+        --e[k].row;
+        --e[k].col;
+    }
+    A.n = rows;
+    A.row_ptr.assign(rows + 1, 0);
+    for (const MatrixMarketEntry &x : e)
+    {
+        ++A.row_ptr[x.row + 1];
+        if (symmetric && x.row != x.col)
+            ++A.row_ptr[x.col + 1];
+    }
+    for (int i = 0; i < rows; ++i)
+    {
+        A.row_ptr[i + 1] += A.row_ptr[i];
+    }
+    vector<size_t> fill(A.row_ptr.begin(), A.row_ptr.end() - 1);
+    A.col.resize(A.row_ptr[rows]);
+    A.val.resize(A.row_ptr[rows]);
+    for (const MatrixMarketEntry &x : e)
+    {
+        A.col[fill[x.row]] = x.col;
+        A.val[fill[x.row]++] = x.val;
+        if (symmetric && x.row != x.col)
+        {
+            A.col[fill[x.col]] = x.row;
+            A.val[fill[x.col]++] = x.val;
+        }
+    }
+    return true;
+}
+
+// largest part / average part, in nonzeros, for the N_THREADS parts of a split
+double imbalance(const CsrMatrix &A, bool by_nonzeros)
+{
+    double largest = 0.0;
+    for (int p = 0; p < N_THREADS; ++p)
+    {
+        int lb = by_nonzeros ? rowBegin(A, p, N_THREADS) : (int)((long long)A.n * p / N_THREADS);
+        int ub = by_nonzeros ? rowBegin(A, p + 1, N_THREADS) : (int)((long long)A.n * (p + 1) / N_THREADS);
+        largest = max(largest, (double)(A.row_ptr[ub] - A.row_ptr[lb]));
+    }
+    return largest / ((double)A.nonzeros() / N_THREADS);
+}
+
+template <typename Solve>
+void run(const char *name, const CsrMatrix &A, const Vector &b, Solve solve, std::ofstream &out)
+{
+    int iter = 0;
+    double t = omp_get_wtime();
+    Vector x = solve(&iter);
+    t = omp_get_wtime() - t;
+    printf("  %-18s %7d it | %.6f sec | residual %.2e\n", name, iter, t, relativeResidual(A, b, x));
+    out << name << "\t" << iter << "\t" << t << "\n";
+}
+
+int main(int argc, char **argv)
+{
+    string path;
+    if (argc > 1)
+    {
+        path = argv[1];
+    }
+    else
+    {
+        int G;
+        cout << "No .mtx file given, generating one. Enter the grid size (G = 100 as an example): ";
+        cin >> G;
+        if (G <= 1)
+        {
+            cout << "Error: G must be greater than 1" << endl;
+            return 1;
+        }
+        writeTestMatrix(GENERATED, G);
+        path = GENERATED;
+    }
+
+    CsrMatrix A, A_stream;
+    string error;
+    double t = omp_get_wtime();
+    if (!loadMatrixMarket(path, A, N_THREADS, &error))
+    {
+        cout << "Error: " << error << endl;
+        return 1;
+    }
+    double t_load = omp_get_wtime() - t;
+
+    t = omp_get_wtime();
+    loadMatrixMarketStream(path, A_stream);
+    double t_stream = omp_get_wtime() - t;
+
+    printf("%s: n = %d, %zu nonzeros | mmap + from_chars: %.6f sec | istream: %.6f sec | Speedup: %.1f\n", path.c_str(),
+           A.size(), A.nonzeros(), t_load, t_stream, t_stream / t_load);
+    printf("Largest of %d parts / average, in nonzeros: equal rows %.2f, rowBegin %.2f\n", N_THREADS,
+           imbalance(A, false), imbalance(A, true));
+
+    int n = A.size();
+    Vector b(n, 1.0);
+    double lambda_min, lambda_max;
+    estimateSpectrum(A, N_THREADS, &lambda_min, &lambda_max);
+    printf("Estimated spectrum [%.4g, %.4g]\n", lambda_min, lambda_max);
+
+    std::ofstream out("Out_sparse.txt");
+    out << "# method  iterations  time\n";
+
+    KrylovWorkspace workspace;
+    run("CG", A, b, [&](int *it) { return conjugateGradientMethod(A, b, EPSILON, N_THREADS, it); }, out);
+    run("Chebyshev", A, b, [&](int *it) {
+        return chebyshevIterationMethod(A, b, lambda_min, lambda_max, EPSILON, N_THREADS, it);
+    }, out);
+    run("GMRES(30)", A, b, [&](int *it) { return gmresMethod(A, b, RESTART, EPSILON, N_THREADS, it, &workspace); }, out);
+    run("BiCGSTAB", A, b, [&](int *it) { return biCGStabMethod(A, b, EPSILON, N_THREADS, it, &workspace); }, out);
+    run("Simple iteration", A, b, [&](int *it) {
+        return simpleIterationMethodFused(A, b, 1.0 / lambda_max, EPSILON, N_THREADS, it);
+    }, out);
+
+    out.close();
+    cout << "File has been written" << std::endl;
+    return 0;
+}
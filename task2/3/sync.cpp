@@ -0,0 +1,250 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <memory>
+#include <time.h>
+#include <omp.h>
+
+#include "matrix.hpp"
+#include "barrier.hpp"
+
+using namespace std;
+
+const double EPSILON = 1e-5;
+const double TAU = 0.000001;
+
+// Per-solve timing: total wall time, and the average over threads of the time spent in
+// the work loops (compute) and everywhere else: barriers, serial sections, imbalance (sync).
+struct SyncStats
+{
+    int iterations = 0;
+    double total = 0.0;
+    double compute = 0.0;
+    double sync = 0.0;
+};
+
+double norm(const Vector &v)
+{
+    double sum = 0.0;
+    for (double val : v)
+    {
+        sum += val * val;
+    }
+    return sqrt(sum);
+}
+
+// task32 version, with timers around the work loops
+Vector simpleIterationMethod(const Matrix &A, const Vector &b, int n_threads, SyncStats *stats)
+{
+    int n = A.size();
+    Vector x(n, 0.0);
+    Vector Ax(n);
+    Vector r(n);
+    bool stop = false;
+    int iterations = 0;
+    vector<PaddedDouble> compute(n_threads);
+    int team = n_threads;
+
+    double t_start = omp_get_wtime();
+    #pragma omp parallel num_threads(n_threads)
+    {
+        int tid = omp_get_thread_num();
+        if (tid == 0)
+            team = omp_get_num_threads();
+        while (true)
+        {
+            #pragma omp single
+            Ax.assign(n, 0.0);
+
+            double t = omp_get_wtime();
+            #pragma omp for nowait
+            for (int i = 0; i < n; ++i)
+            {
+                for (int j = 0; j < n; ++j)
+                {
+                    Ax[i] += A[i][j] * x[j];
+                }
+            }
+            compute[tid].value += omp_get_wtime() - t;
+
+            #pragma omp single
+            r.assign(n, 0.0);
+
+            t = omp_get_wtime();
+            #pragma omp for nowait
+            for (int i = 0; i < n; ++i)
+            {
+                r[i] = Ax[i] - b[i];
+            }
+            compute[tid].value += omp_get_wtime() - t;
+
+            #pragma omp single
+            {
+                if (norm(r) / norm(b) < EPSILON)
+                {
+                    stop = true;
+                }
+                ++iterations;
+            }
+
+            if (stop)
+                break;
+
+            t = omp_get_wtime();
+            #pragma omp for nowait
+            for (int i = 0; i < n; ++i)
+            {
+                x[i] -= TAU * r[i];
+            }
+            compute[tid].value += omp_get_wtime() - t;
+        }
+    }
+    stats->total = omp_get_wtime() - t_start;
+    stats->iterations = iterations;
+    for (int k = 0; k < team; ++k)
+    {
+        stats->compute += compute[k].value / team;
+    }
+    stats->sync = stats->total - stats->compute;
+    return x;
+}
+
+// One synchronization point per iteration. Each thread owns a static block of rows and
+// computes (A x)_i, r_i, r_i^2 and the new x_i for it in one pass, writing the new x into
+// the other of two buffers and its partial ||r||^2 into its own padded slot. After the
+// single barrier every thread adds up the n_threads slots itself, so all of them reach
+// the same stop decision without a broadcast. Buffers and slots alternate by iteration
+// parity: a slot is rewritten only two iterations later, after everybody has read it.
+// The barrier is built inside the region for the team OpenMP actually started: a custom
+// barrier counting n_threads arrivals would spin forever in a smaller team.
+template <typename Barrier>
+Vector simpleIterationMethodOneBarrier(const Matrix &A, const Vector &b, int n_threads, SyncStats *stats)
+{
+    int n = A.size();
+    Vector x[2] = {Vector(n, 0.0), Vector(n)};
+    vector<PaddedDouble> partial[2] = {vector<PaddedDouble>(n_threads), vector<PaddedDouble>(n_threads)};
+    vector<PaddedDouble> compute(n_threads), wait(n_threads);
+    std::unique_ptr<Barrier> barrier;
+    int team = n_threads;
+    int iterations = 0;
+    int result = 0;
+
+    double b_norm2 = 0.0;
+    for (int i = 0; i < n; ++i)
+    {
+        b_norm2 += b[i] * b[i];
+    }
+
+    double t_start = omp_get_wtime();
+    #pragma omp parallel num_threads(n_threads)
+    {
+        int tid = omp_get_thread_num();
+        int nthreads = omp_get_num_threads();
+        int items_per_thread = n / nthreads;
+        int lb = tid * items_per_thread;
+        int ub = (tid == nthreads - 1) ? n : lb + items_per_thread;
+
+        #pragma omp single
+        {
+            team = nthreads;
+            barrier.reset(new Barrier(nthreads));
+        }
+
+        for (int k = 0;; ++k)
+        {
+            const double *xk = x[k & 1].data();
+            double *xn = x[(k + 1) & 1].data();
+
+            double t = omp_get_wtime();
+            double rr = 0.0;
+            for (int i = lb; i < ub; ++i)
+            {
+                double ri = rowDot(A, i, xk) - b[i];
+                rr += ri * ri;
+                xn[i] = xk[i] - TAU * ri;
+            }
+            partial[k & 1][tid].value = rr;
+            double t_barrier = omp_get_wtime();
+            compute[tid].value += t_barrier - t;
+
+            barrier->wait(tid);
+            wait[tid].value += omp_get_wtime() - t_barrier;
+
+            double r_norm2 = 0.0;
+            for (int p = 0; p < nthreads; ++p)
+            {
+                r_norm2 += partial[k & 1][p].value;
+            }
+            if (sqrt(r_norm2 / b_norm2) < EPSILON)
+            {
+                if (tid == 0)
+                {
+                    iterations = k + 1;
+                    result = k & 1; // the residual was measured for x[k & 1]
+                }
+                break;
+            }
+        }
+    }
+    stats->total = omp_get_wtime() - t_start;
+    stats->iterations = iterations;
+    for (int k = 0; k < team; ++k)
+    {
+        stats->compute += compute[k].value / team;
+        stats->sync += wait[k].value / team;
+    }
+    return x[result];
+}
+
+void report(const char *name, int n_threads, const SyncStats &s, std::ofstream &out)
+{
+    double per_it = 1e3 / s.iterations;
+    printf("  %-20s threads %2d | %d it | %.6f sec | per iteration: total %.4f ms, compute %.4f ms, sync %.4f ms (%.0f%%)\n",
+           name, n_threads, s.iterations, s.total, s.total * per_it, s.compute * per_it, s.sync * per_it,
+           100.0 * s.sync / s.total);
+    out << name << "\t" << n_threads << "\t" << s.total << "\t" << s.compute << "\t" << s.sync << "\n";
+}
+
+int main()
+{
+    int N;
+    cout << "Enter the number of equations (N = 5000 as an example): ";
+    cin >> N;
+
+    if (N <= 0)
+    {
+        cout << "Error: N must be greater than 0" << endl;
+        return 1;
+    }
+
+    Matrix A(N, 1.0);
+    Vector b(N, N + 1);
+    for (int i = 0; i < N; ++i)
+    {
+        A[i][i] = 2.0;
+    }
+
+    std::ofstream out("Out_sync.txt");
+    out << "# method  threads  time  compute  sync\n";
+
+    vector<int> thread_counts = {2, 4, 8, 16, 20, 40, 80};
+    for (int n_threads : thread_counts)
+    {
+        if (n_threads > N)
+            break;
+
+        SyncStats s_task32, s_omp, s_sense;
+        simpleIterationMethod(A, b, n_threads, &s_task32);
+        simpleIterationMethodOneBarrier<OmpBarrier>(A, b, n_threads, &s_omp);
+        simpleIterationMethodOneBarrier<SenseBarrier>(A, b, n_threads, &s_sense);
+
+        report("task32", n_threads, s_task32, out);
+        report("one-barrier (omp)", n_threads, s_omp, out);
+        report("one-barrier (sense)", n_threads, s_sense, out);
+    }
+
+    out.close();
+    cout << "File has been written" << std::endl;
+    return 0;
+}
@@ -5,14 +5,13 @@
 #include <time.h>
 #include <omp.h>
 
+#include "matrix.hpp"
+
 using namespace std;
 
 const double EPSILON = 1e-5;
 const double TAU = 0.000001;
 
-using Vector = vector<double>;
-using Matrix = vector<Vector>;
-
 double norm(const Vector &v)
 {
     double sum = 0.0;
@@ -96,7 +95,7 @@ int main()
 
     for (int n_threads = 2; n_threads <= min(80, N); n_threads++)
     {
-        Matrix A(N, Vector(N, 1.0));
+        Matrix A(N, 1.0);
         Vector b(N, N + 1);
 
         #pragma omp parallel for num_threads(n_threads)
@@ -5,6 +5,9 @@
 #include <time.h>
 #include <omp.h>
 
+#include "matrix.hpp"
+#include "tuner.hpp"
+
 #define N_THREADS 8
 #define N 5000
 
@@ -13,9 +16,6 @@ using namespace std;
 const double EPSILON = 1e-5;
 const double TAU = 0.000001;
 
-using Vector = vector<double>;
-using Matrix = vector<Vector>;
-
 double norm(const Vector &v)
 {
     double sum = 0.0;
@@ -26,63 +26,37 @@ double norm(const Vector &v)
     return sqrt(sum);
 }
 
-Vector simpleIterationMethod(const Matrix &A, const Vector &b, int n_threads, const string &schedule_type, int chunk_size)
+// The matrix-vector loop uses schedule(runtime). Without a tuner it runs with the schedule
+// the caller set through omp_set_schedule; with a tuner every thread applies the tuner's
+// current choice at the start of each iteration and the iteration time is fed back.
+Vector simpleIterationMethod(const Matrix &A, const Vector &b, int n_threads, ScheduleTuner *tuner)
 {
     int n = A.size();
     Vector x(n, 0.0);
     Vector Ax(n);
     Vector r(n);
     bool stop = false;
+    double t_iter = 0.0;
 
     #pragma omp parallel num_threads(n_threads)
     {
         while (true)
         {
-            #pragma omp single
-            Ax.assign(n, 0.0);
+            if (tuner != nullptr)
+                tuner->apply();
 
-            if (schedule_type == "static")
-            {
-                #pragma omp for schedule(static, chunk_size) nowait
-                for (int i = 0; i < n; ++i)
-                {
-                    for (int j = 0; j < n; ++j)
-                    {
-                        Ax[i] += A[i][j] * x[j];
-                    }
-                }
-            }
-            else if (schedule_type == "dynamic")
-            {
-                #pragma omp for schedule(dynamic, chunk_size) nowait
-                for (int i = 0; i < n; ++i)
-                {
-                    for (int j = 0; j < n; ++j)
-                    {
-                        Ax[i] += A[i][j] * x[j];
-                    }
-                }
-            }
-            else if (schedule_type == "guided")
+            #pragma omp single
             {
-                #pragma omp for schedule(guided, chunk_size) nowait
-                for (int i = 0; i < n; ++i)
-                {
-                    for (int j = 0; j < n; ++j)
-                    {
-                        Ax[i] += A[i][j] * x[j];
-                    }
-                }
+                Ax.assign(n, 0.0);
+                t_iter = omp_get_wtime();
             }
-            else if (schedule_type == "auto")
+
+            #pragma omp for schedule(runtime) nowait
+            for (int i = 0; i < n; ++i)
             {
-                #pragma omp for schedule(auto) nowait
-                for (int i = 0; i < n; ++i)
+                for (int j = 0; j < n; ++j)
                 {
-                    for (int j = 0; j < n; ++j)
-                    {
-                        Ax[i] += A[i][j] * x[j];
-                    }
+                    Ax[i] += A[i][j] * x[j];
                 }
             }
 
@@ -101,6 +75,8 @@ Vector simpleIterationMethod(const Matrix &A, const Vector &b, int n_threads, co
                 {
                     stop = true;
                 }
+                if (tuner != nullptr)
+                    tuner->record(omp_get_wtime() - t_iter);
             }
 
             if (stop)
@@ -119,7 +95,7 @@ Vector simpleIterationMethod(const Matrix &A, const Vector &b, int n_threads, co
 
 int main()
 {
-    vector<string> schedules = {"static", "dynamic", "guided", "auto"};
+    vector<omp_sched_t> schedules = {omp_sched_static, omp_sched_dynamic, omp_sched_guided, omp_sched_auto};
     vector<int> chunk_sizes = {1, 10, 100, 1000};
 
     std::ofstream out("Out_task33.txt");
@@ -129,7 +105,7 @@ int main()
     {
         for (int chunk_size : chunk_sizes)
         {
-            Matrix A(N, Vector(N, 1.0));
+            Matrix A(N, 1.0);
             Vector b(N, N + 1);
 
             #pragma omp parallel for num_threads(N_THREADS)
@@ -138,15 +114,41 @@ int main()
                 A[i][i] = 2.0;
             }
 
+            omp_set_schedule(schedule, chunk_size);
+
             double t = omp_get_wtime();
-            Vector solution = simpleIterationMethod(A, b, N_THREADS, schedule, chunk_size);
+            Vector solution = simpleIterationMethod(A, b, N_THREADS, nullptr);
             t = omp_get_wtime() - t;
 
-            printf("Threads: %d | Schedule: %s | Chunk: %d | Time: %.6f sec\n", N_THREADS, schedule.c_str(), chunk_size, t);
-            out << N_THREADS << "\t" << schedule << "\t" << chunk_size << "\t" << t << "\t" << 85.948490 / t << "\n";
+            printf("Threads: %d | Schedule: %s | Chunk: %d | Time: %.6f sec\n", N_THREADS, scheduleName(schedule), chunk_size, t);
+            out << N_THREADS << "\t" << scheduleName(schedule) << "\t" << chunk_size << "\t" << t << "\t" << 85.948490 / t << "\n";
         }
     }
 
+    // online tuning: candidates are tried during the first iterations of the solve itself
+    {
+        Matrix A(N, 1.0);
+        Vector b(N, N + 1);
+
+        #pragma omp parallel for num_threads(N_THREADS)
+        for (int i = 0; i < N; ++i)
+        {
+            A[i][i] = 2.0;
+        }
+
+        ScheduleTuner tuner(N, N_THREADS);
+        bool cached = tuner.fromCache();
+
+        double t = omp_get_wtime();
+        Vector solution = simpleIterationMethod(A, b, N_THREADS, &tuner);
+        t = omp_get_wtime() - t;
+
+        ScheduleChoice c = tuner.choice();
+        printf("Threads: %d | Tuned (%s): %s, chunk %d | Time: %.6f sec\n", N_THREADS, cached ? "from cache" : "online",
+               scheduleName(c.kind), c.chunk, t);
+        out << N_THREADS << "\ttuned-" << scheduleName(c.kind) << "\t" << c.chunk << "\t" << t << "\t" << 85.948490 / t << "\n";
+    }
+
     out.close();
     cout << "File has been written" << std::endl;
 
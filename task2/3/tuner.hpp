@@ -0,0 +1,159 @@
+#pragma once
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <omp.h>
+
+#define TUNER_TRIALS 3 // iterations timed per candidate
+#define TUNER_CACHE "schedule_cache.txt"
+
+struct ScheduleChoice
+{
+    omp_sched_t kind;
+    int chunk;
+};
+
+inline const char *scheduleName(omp_sched_t kind)
+{
+    switch (kind)
+    {
+    case omp_sched_static:
+        return "static";
+    case omp_sched_dynamic:
+        return "dynamic";
+    case omp_sched_guided:
+        return "guided";
+    default:
+        return "auto";
+    }
+}
+
+// Picks the OpenMP schedule of the hot loop while the solver runs. Loops that should
+// be tuned use schedule(runtime); at the start of every iteration each thread calls
+// apply(), which sets its run-sched-var to the current candidate. After the iteration
+// one thread calls record() with the elapsed time. Every candidate gets TUNER_TRIALS
+// iterations, then the fastest one is kept for the rest of the solve and stored in the
+// cache file under (host, n, threads), so the next run with the same key starts tuned.
+class ScheduleTuner
+{
+public:
+    ScheduleTuner(int n, int n_threads, const std::string &cache_path = TUNER_CACHE)
+        : n(n), n_threads(n_threads), cache_path(cache_path), current(0), trials(0), locked(false)
+    {
+        char buf[256] = "unknown";
+        gethostname(buf, sizeof(buf) - 1);
+        host = buf;
+
+        const omp_sched_t kinds[] = {omp_sched_static, omp_sched_dynamic, omp_sched_guided};
+        const int chunks[] = {1, 10, 100, 1000};
+        for (omp_sched_t kind : kinds)
+        {
+            for (int chunk : chunks)
+            {
+                candidates.push_back({kind, chunk});
+            }
+        }
+        candidates.push_back({omp_sched_auto, 0});
+        times.assign(candidates.size(), 0.0);
+
+        if (load())
+        {
+            locked = true;
+            from_cache = true;
+        }
+    }
+
+    // called by every thread of the team, between barriers
+    void apply() const
+    {
+        const ScheduleChoice &c = locked ? best : candidates[current];
+        omp_set_schedule(c.kind, c.chunk);
+    }
+
+    // called by one thread after each iteration
+    void record(double elapsed)
+    {
+        if (locked)
+            return;
+        times[current] += elapsed;
+        if (++trials < TUNER_TRIALS)
+            return;
+        trials = 0;
+        if (++current < candidates.size())
+            return;
+
+        size_t fastest = 0;
+        for (size_t k = 1; k < candidates.size(); ++k)
+        {
+            if (times[k] < times[fastest])
+                fastest = k;
+        }
+        best = candidates[fastest];
+        locked = true;
+        save();
+    }
+
+    bool isLocked() const { return locked; }
+    bool fromCache() const { return from_cache; }
+    ScheduleChoice choice() const { return locked ? best : candidates[current]; }
+
+private:
+    bool load()
+    {
+        std::ifstream in(cache_path);
+        std::string line;
+        while (std::getline(in, line))
+        {
+            std::istringstream fields(line);
+            std::string h;
+            int cached_n, cached_threads, kind, chunk;
+            if (fields >> h >> cached_n >> cached_threads >> kind >> chunk &&
+                h == host && cached_n == n && cached_threads == n_threads)
+            {
+                best = {(omp_sched_t)kind, chunk};
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // rewrite the file, replacing the line with our key if there is one
+    void save() const
+    {
+        std::vector<std::string> lines;
+        {
+            std::ifstream in(cache_path);
+            std::string line;
+            while (std::getline(in, line))
+            {
+                std::istringstream fields(line);
+                std::string h;
+                int cached_n, cached_threads;
+                if (fields >> h >> cached_n >> cached_threads && h == host && cached_n == n && cached_threads == n_threads)
+                    continue;
+                lines.push_back(line);
+            }
+        }
+        std::ofstream out(cache_path);
+        for (const std::string &line : lines)
+        {
+            out << line << "\n";
+        }
+        out << host << " " << n << " " << n_threads << " " << (int)best.kind << " " << best.chunk << "\n";
+    }
+
+    int n;
+    int n_threads;
+    std::string cache_path;
+    std::string host;
+    std::vector<ScheduleChoice> candidates;
+    std::vector<double> times;
+    size_t current;
+    int trials;
+    bool locked;
+    bool from_cache = false;
+    ScheduleChoice best = {omp_sched_static, 0};
+};
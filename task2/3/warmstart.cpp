@@ -0,0 +1,121 @@
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <time.h>
+#include <omp.h>
+
+#include "matrix.hpp"
+#include "iteration.hpp"
+#include "warmstart.hpp"
+
+#define N_THREADS 8
+
+using namespace std;
+
+const double EPSILON = 1e-5;
+
+const char *matchName(WarmMatch m)
+{
+    switch (m)
+    {
+    case WarmMatch::Exact:
+        return "exact";
+    case WarmMatch::Nearest:
+        return "nearest";
+    default:
+        return "none";
+    }
+}
+
+// Solve through the cache: fingerprint, look up, solve from the seed (or from zero), store
+int solveCached(WarmStartCache &cache, const Matrix &A, const Vector &b, double tau, int cold_iterations,
+                std::ofstream &out, const char *name)
+{
+    double t = omp_get_wtime();
+    SystemKey key = systemKey(A, b, N_THREADS);
+    double t_hash = omp_get_wtime() - t;
+
+    Vector x0;
+    WarmMatch match = cache.lookup(key, b, N_THREADS, x0);
+
+    int iterations;
+    t = omp_get_wtime();
+    Vector x = simpleIterationMethodFused(A, b, tau, EPSILON, N_THREADS, &iterations,
+                                         match != WarmMatch::None ? &x0 : nullptr);
+    double t_solve = omp_get_wtime() - t;
+    cache.store(key, b, x);
+
+    printf("%-22s | match: %-7s | hash %.6f sec | %5d it, %.6f sec | iterations saved: %d\n", name,
+           matchName(match), t_hash, iterations, t_solve, cold_iterations - iterations);
+    out << name << "\t" << matchName(match) << "\t" << iterations << "\t" << t_solve << "\n";
+    return iterations;
+}
+
+// The cache file is kept between runs, so a second run finds the systems of the first one
+// (exact matches from the start). "--clear" deletes it first, for a cold run.
+int main(int argc, char **argv)
+{
+    const bool clear = argc > 1 && strcmp(argv[1], "--clear") == 0;
+
+    int N;
+    cout << "Enter the number of equations (N = 5000 as an example): ";
+    cin >> N;
+
+    if (N <= 0)
+    {
+        cout << "Error: N must be greater than 0" << endl;
+        return 1;
+    }
+
+    Matrix A(N, 1.0);
+    Vector b(N, N + 1);
+    for (int i = 0; i < N; ++i)
+    {
+        A[i][i] = 2.0;
+    }
+
+    // The task's TAU = 1e-6 removes error outside the direction of 1 by a factor 1 - 1e-6
+    // per iteration, so any b that is not a multiple of 1 practically never converges.
+    // 2 / (lambda_min + lambda_max), with the spectrum {1, N + 1} of A, converges for all of them.
+    const double tau = 2.0 / (N + 2);
+
+    // b scaled by 5% plus a 1% perturbation: a different system for the exact key, close
+    // enough for the nearest match, and far enough for the seed to leave work to do
+    Vector b_near(N);
+    for (int i = 0; i < N; ++i)
+    {
+        b_near[i] = 1.05 * b[i] + 0.01 * (N + 1) * sin(i);
+    }
+
+    std::ofstream out("Out_warmstart.txt");
+    out << "# case  match  iterations  time\n";
+
+    // cold iteration counts, without the cache, for "iterations saved"
+    int cold, cold_near;
+    simpleIterationMethodFused(A, b, tau, EPSILON, N_THREADS, &cold);
+    simpleIterationMethodFused(A, b_near, tau, EPSILON, N_THREADS, &cold_near);
+
+    if (clear)
+    {
+        remove(WARM_CACHE);
+    }
+    {
+        WarmStartCache cache;
+        printf("Loaded %zu entries from %s\n", cache.size(), WARM_CACHE);
+        solveCached(cache, A, b, tau, cold, out, "task system");
+        solveCached(cache, A, b, tau, cold, out, "same system");
+        solveCached(cache, A, b_near, tau, cold_near, out, "perturbed b");
+    }
+    {
+        WarmStartCache cache; // a new process would see the same file
+        printf("Reloaded %zu entries from %s\n", cache.size(), WARM_CACHE);
+        solveCached(cache, A, b, tau, cold, out, "same system, reloaded");
+    }
+
+    out.close();
+    cout << "File has been written" << std::endl;
+    return 0;
+}
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <omp.h>
+
+#include "hash.hpp"
+#include "matrix.hpp"
+
+#define WARM_CACHE "warm_start.bin"
+#define WARM_CAPACITY 32      // solutions kept; the oldest one is dropped first
+#define WARM_MAX_DISTANCE 0.5 // nearest match only if ||b - alpha b_e|| / ||b|| is below this
+
+// ---- fingerprints ----
+
+struct SystemKey
+{
+    uint64_t a = 0;
+    uint64_t b = 0;
+    int n = 0;
+};
+
+inline SystemKey systemKey(const Matrix &A, const Vector &b, int n_threads)
+{
+    return {hashMatrix(A, n_threads), hashVector(b, n_threads), A.size()};
+}
+
+// ---- cache ----
+
+enum class WarmMatch
+{
+    None,
+    Exact,
+    Nearest
+};
+
+// Solutions of earlier solves, by (hash of A, hash of b). lookup() gives the stored x for
+// the same system; with nearest it falls back to the entry with the same A whose b is
+// closest to the new one after scaling: x0 = alpha x_e, alpha = (b, b_e) / (b_e, b_e),
+// which is exact when b is a multiple of b_e.
+// The cache lives in a binary file, rewritten on every store():
+//   "WSC1", int32 count, then per entry: uint64 a, uint64 b, int32 n, n floats b, n doubles x.
+// b is kept in single precision, it is only used to measure distances.
+// The file is written to path + ".tmp" and renamed over path, so a crash while writing
+// leaves the previous file intact. load() stops at the first entry that does not fit in
+// what is left of the file (truncated or foreign data) and keeps the entries before it.
+class WarmStartCache
+{
+public:
+    explicit WarmStartCache(const std::string &path = WARM_CACHE, int capacity = WARM_CAPACITY)
+        : path(path), capacity(capacity)
+    {
+        load();
+    }
+
+    WarmMatch lookup(const SystemKey &key, const Vector &b, int n_threads, Vector &x0, bool nearest = true) const
+    {
+        for (const Entry &e : entries)
+        {
+            if (e.key.a == key.a && e.key.b == key.b && e.key.n == key.n)
+            {
+                x0 = e.x;
+                return WarmMatch::Exact;
+            }
+        }
+        if (!nearest)
+            return WarmMatch::None;
+
+        const Entry *best = nullptr;
+        double best_distance = WARM_MAX_DISTANCE, best_alpha = 0.0;
+        for (const Entry &e : entries)
+        {
+            if (e.key.a != key.a || e.key.n != key.n)
+                continue;
+            double bb = 0.0, be = 0.0, ee = 0.0;
+            #pragma omp parallel for reduction(+:bb, be, ee) schedule(static) num_threads(n_threads)
+            for (int i = 0; i < key.n; ++i)
+            {
+                bb += b[i] * b[i];
+                be += b[i] * e.b[i];
+                ee += (double)e.b[i] * e.b[i];
+            }
+            if (ee == 0.0 || bb == 0.0)
+                continue;
+            double alpha = be / ee;
+            double distance = sqrt(std::max(0.0, bb - alpha * be) / bb); // ||b - alpha b_e|| / ||b||
+            if (distance < best_distance)
+            {
+                best = &e;
+                best_distance = distance;
+                best_alpha = alpha;
+            }
+        }
+        if (best == nullptr)
+            return WarmMatch::None;
+
+        x0.resize(key.n);
+        #pragma omp parallel for schedule(static) num_threads(n_threads)
+        for (int i = 0; i < key.n; ++i)
+        {
+            x0[i] = best_alpha * best->x[i];
+        }
+        return WarmMatch::Nearest;
+    }
+
+    // false if the file could not be written; the entry is kept in memory either way
+    bool store(const SystemKey &key, const Vector &b, const Vector &x)
+    {
+        for (auto it = entries.begin(); it != entries.end(); ++it)
+        {
+            if (it->key.a == key.a && it->key.b == key.b && it->key.n == key.n)
+            {
+                entries.erase(it);
+                break;
+            }
+        }
+        if ((int)entries.size() >= capacity)
+        {
+            entries.erase(entries.begin());
+        }
+        entries.push_back({key, std::vector<float>(b.begin(), b.end()), x});
+        return save();
+    }
+
+    size_t size() const { return entries.size(); }
+
+private:
+    struct Entry
+    {
+        SystemKey key;
+        std::vector<float> b;
+        Vector x;
+    };
+
+    bool load()
+    {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in)
+            return false;
+        const long long file_size = in.tellg();
+        in.seekg(0);
+
+        char magic[4];
+        int32_t count;
+        if (!in.read(magic, 4) || memcmp(magic, "WSC1", 4) != 0 || !in.read((char *)&count, sizeof(count)))
+            return false;
+        for (int k = 0; k < count; ++k)
+        {
+            Entry e;
+            int32_t n;
+            if (!in.read((char *)&e.key.a, sizeof(e.key.a)) || !in.read((char *)&e.key.b, sizeof(e.key.b)) ||
+                !in.read((char *)&n, sizeof(n)) || n <= 0)
+                break;
+            const long long left = file_size - (long long)in.tellg();
+            if ((long long)n > left / (long long)(sizeof(float) + sizeof(double)))
+                break;
+            e.key.n = n;
+            e.b.resize(n);
+            e.x.resize(n);
+            if (!in.read((char *)e.b.data(), n * sizeof(float)) || !in.read((char *)e.x.data(), n * sizeof(double)))
+                break;
+            entries.push_back(std::move(e));
+        }
+        while ((int)entries.size() > capacity)
+        {
+            entries.erase(entries.begin());
+        }
+        return true;
+    }
+
+    bool save() const
+    {
+        const std::string tmp = path + ".tmp";
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        int32_t count = entries.size();
+        out.write("WSC1", 4);
+        out.write((const char *)&count, sizeof(count));
+        for (const Entry &e : entries)
+        {
+            int32_t n = e.key.n;
+            out.write((const char *)&e.key.a, sizeof(e.key.a));
+            out.write((const char *)&e.key.b, sizeof(e.key.b));
+            out.write((const char *)&n, sizeof(n));
+            out.write((const char *)e.b.data(), n * sizeof(float));
+            out.write((const char *)e.x.data(), n * sizeof(double));
+        }
+        out.close();
+        if (!out || std::rename(tmp.c_str(), path.c_str()) != 0)
+        {
+            std::remove(tmp.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    std::string path;
+    int capacity;
+    std::vector<Entry> entries;
+};
@@ -0,0 +1,133 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cmath>
+#include <time.h>
+#include <omp.h>
+
+#include "matrix.hpp"
+#include "iteration.hpp"
+#include "woodbury.hpp"
+
+#define N_THREADS 8
+#define RANK 8
+
+using namespace std;
+
+const double EPSILON = 1e-5;
+const double TAU = 0.000001;
+
+double relativeResidual(const Matrix &A, const Vector &b, const Vector &x)
+{
+    double rr = 0.0, bb = 0.0;
+    for (int i = 0; i < A.size(); ++i)
+    {
+        double r = rowDot(A, i, x.data()) - b[i];
+        rr += r * r;
+        bb += b[i] * b[i];
+    }
+    return sqrt(rr / bb);
+}
+
+int main()
+{
+    int max_N;
+    cout << "Enter the largest number of equations (N = 5000 as an example): ";
+    cin >> max_N;
+
+    if (max_N <= 0)
+    {
+        cout << "Error: N must be greater than 0" << endl;
+        return 1;
+    }
+
+    std::ofstream out("Out_woodbury.txt");
+    out << "# N  simple_time  woodbury_time  speedup\n";
+
+    // task matrix I + 11^T: detected as diagonal plus rank 1
+    for (int N = 500; N <= max_N; N *= 2)
+    {
+        Matrix A(N, 1.0);
+        Vector b(N, N + 1);
+        for (int i = 0; i < N; ++i)
+        {
+            A[i][i] = 2.0;
+        }
+
+        double t = omp_get_wtime();
+        Vector x_simple = simpleIterationMethodFused(A, b, TAU, EPSILON, N_THREADS);
+        double t_simple = omp_get_wtime() - t;
+
+        bool structured;
+        t = omp_get_wtime();
+        Vector x_fast = solveStructured(A, b, EPSILON, N_THREADS, &structured);
+        double t_fast = omp_get_wtime() - t;
+
+        printf("N: %d | Simple iteration: %.6f sec, residual %.2e | %s: %.6f sec, residual %.2e | Speedup: %.1f\n",
+               N, t_simple, relativeResidual(A, b, x_simple), structured ? "Woodbury" : "iterative fallback",
+               t_fast, relativeResidual(A, b, x_fast), t_simple / t_fast);
+        out << N << "\t" << t_simple << "\t" << t_fast << "\t" << t_simple / t_fast << "\n";
+    }
+
+    // explicit D + U V^T of rank RANK, solved without ever forming A
+    LowRankOperator op;
+    op.n = max_N;
+    op.k = RANK;
+    op.d.resize(max_N);
+    op.U.resize((size_t)max_N * RANK);
+    op.V.resize((size_t)max_N * RANK);
+    for (int i = 0; i < max_N; ++i)
+    {
+        op.d[i] = 2.0 + i % 3;
+        for (int l = 0; l < RANK; ++l)
+        {
+            op.U[i * RANK + l] = cos(0.01 * (i + 1) * (l + 1));
+            op.V[i * RANK + l] = sin(0.02 * (i + 1) * (l + 1));
+        }
+    }
+    Vector b(max_N, 1.0), x;
+
+    double t = omp_get_wtime();
+    bool ok = woodburySolve(op, b, x, N_THREADS);
+    t = omp_get_wtime() - t;
+
+    // residual through the factored form: D x + U (V^T x)
+    Vector vx(RANK, 0.0);
+    for (int i = 0; i < max_N; ++i)
+        for (int l = 0; l < RANK; ++l)
+            vx[l] += op.V[i * RANK + l] * x[i];
+    double rr = 0.0;
+    for (int i = 0; i < max_N; ++i)
+    {
+        double r = op.d[i] * x[i] - b[i];
+        for (int l = 0; l < RANK; ++l)
+            r += op.U[i * RANK + l] * vx[l];
+        rr += r * r;
+    }
+    printf("Rank %d, N: %d | Woodbury: %s, %.6f sec, residual %.2e\n", RANK, max_N, ok ? "ok" : "singular", t, sqrt(rr / max_N));
+
+    // symmetric indefinite, not low rank: CG breaks down, solveStructured switches to BiCGSTAB
+    {
+        Matrix A(max_N, 0.0);
+        Vector b(max_N, 1.0);
+        for (int i = 0; i < max_N; ++i)
+        {
+            A[i][i] = (i % 2 == 0) ? 3.0 : -3.0;
+            if (i > 0)
+                A[i][i - 1] = A[i - 1][i] = 1.0;
+        }
+
+        bool breakdown;
+        int iter;
+        conjugateGradientMethod(A, b, EPSILON, N_THREADS, &iter, nullptr, &breakdown);
+        t = omp_get_wtime();
+        Vector x_fallback = solveStructured(A, b, EPSILON, N_THREADS);
+        t = omp_get_wtime() - t;
+        printf("Indefinite, N: %d | CG: %s after %d it | fallback: %.6f sec, residual %.2e\n", max_N,
+               breakdown ? "breakdown" : "no breakdown", iter, t, relativeResidual(A, b, x_fallback));
+    }
+
+    out.close();
+    cout << "File has been written" << std::endl;
+    return 0;
+}
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <cmath>
+#include <utility>
+#include <vector>
+#include <omp.h>
+
+#include "matrix.hpp"
+#include "cg.hpp"
+#include "krylov.hpp"
+
+#define LOW_RANK_TOLERANCE 1e-12 // relative tolerance when checking that A - D is rank 1
+#define SYMMETRY_TOLERANCE 1e-12 // relative tolerance when checking that A = A^T
+
+// A = D + U V^T with D diagonal and U, V of size n x k. U and V are stored row-major
+// (entry (i, l) at [i * k + l]), so one row of both is read per row of A.
+struct LowRankOperator
+{
+    int n = 0;
+    int k = 0;
+    Vector d;
+    Vector U;
+    Vector V;
+
+    int size() const { return n; }
+};
+
+// Checks whether A = D + u v^T (rank 1 off the diagonal) and if so fills op.
+// u and v are read off rows 0 and 1, then every off-diagonal entry is verified in parallel.
+inline bool detectDiagonalPlusRankOne(const Matrix &A, int n_threads, LowRankOperator *op)
+{
+    int n = A.size();
+    if (n < 3 || A[0][1] == 0.0 || A[0][2] == 0.0)
+    {
+        return false;
+    }
+
+    Vector u(n), v(n);
+    u[0] = 1.0;
+    for (int j = 1; j < n; ++j)
+    {
+        v[j] = A[0][j];
+    }
+    u[1] = A[1][2] / v[2];
+    if (u[1] == 0.0)
+    {
+        return false;
+    }
+    v[0] = A[1][0] / u[1];
+    if (v[0] == 0.0)
+    {
+        return false;
+    }
+
+    bool ok = true;
+
+    #pragma omp parallel num_threads(n_threads)
+    {
+        #pragma omp for
+        for (int i = 2; i < n; ++i)
+        {
+            u[i] = A[i][0] / v[0];
+        }
+
+        #pragma omp for reduction(&&:ok) schedule(static)
+        for (int i = 0; i < n; ++i)
+        {
+            const double *row = A[i];
+            bool row_ok = true;
+            for (int j = 0; j < n && row_ok; ++j)
+            {
+                double uv = u[i] * v[j];
+                if (j != i && fabs(row[j] - uv) > LOW_RANK_TOLERANCE * fmax(fabs(row[j]), fabs(uv)))
+                {
+                    row_ok = false;
+                }
+            }
+            ok = ok && row_ok;
+        }
+    }
+    if (!ok)
+    {
+        return false;
+    }
+
+    op->n = n;
+    op->k = 1;
+    op->d.resize(n);
+    for (int i = 0; i < n; ++i)
+    {
+        op->d[i] = A[i][i] - u[i] * v[i];
+    }
+    op->U.swap(u);
+    op->V.swap(v);
+    return true;
+}
+
+// Solves the small dense system C s = t (k x k, row-major) by Gaussian elimination
+// with partial pivoting. C and t are overwritten. Returns false if C is singular.
+inline bool solveSmall(std::vector<double> &C, std::vector<double> &t, int k)
+{
+    for (int c = 0; c < k; ++c)
+    {
+        int piv = c;
+        for (int i = c + 1; i < k; ++i)
+        {
+            if (fabs(C[i * k + c]) > fabs(C[piv * k + c]))
+                piv = i;
+        }
+        if (C[piv * k + c] == 0.0)
+        {
+            return false;
+        }
+        if (piv != c)
+        {
+            for (int j = 0; j < k; ++j)
+                std::swap(C[c * k + j], C[piv * k + j]);
+            std::swap(t[c], t[piv]);
+        }
+        for (int i = c + 1; i < k; ++i)
+        {
+            double f = C[i * k + c] / C[c * k + c];
+            for (int j = c; j < k; ++j)
+                C[i * k + j] -= f * C[c * k + j];
+            t[i] -= f * t[c];
+        }
+    }
+    for (int c = k - 1; c >= 0; --c)
+    {
+        for (int j = c + 1; j < k; ++j)
+            t[c] -= C[c * k + j] * t[j];
+        t[c] /= C[c * k + c];
+    }
+    return true;
+}
+
+// Sherman-Morrison-Woodbury: (D + U V^T)^{-1} b = y - W (I + V^T W)^{-1} V^T y,
+// with y = D^{-1} b and W = D^{-1} U. O(n k^2) work in two parallel passes;
+// only the k x k system is solved serially. Returns false if D or I + V^T W is singular.
+inline bool woodburySolve(const LowRankOperator &A, const Vector &b, Vector &x, int n_threads)
+{
+    int n = A.n, k = A.k;
+    Vector W((size_t)n * k);
+    x.resize(n);
+    std::vector<double> C((size_t)k * k, 0.0);
+    std::vector<double> t(k, 0.0);
+    bool singular = false;
+
+    #pragma omp parallel num_threads(n_threads)
+    {
+        std::vector<double> C_loc((size_t)k * k, 0.0);
+        std::vector<double> t_loc(k, 0.0);
+
+        #pragma omp for schedule(static) reduction(||:singular)
+        for (int i = 0; i < n; ++i)
+        {
+            if (A.d[i] == 0.0)
+            {
+                singular = true;
+                continue;
+            }
+            double inv = 1.0 / A.d[i];
+            x[i] = b[i] * inv;
+            for (int l = 0; l < k; ++l)
+            {
+                W[i * k + l] = A.U[i * k + l] * inv;
+            }
+            for (int l = 0; l < k; ++l)
+            {
+                double vil = A.V[i * k + l];
+                t_loc[l] += vil * x[i];
+                for (int m = 0; m < k; ++m)
+                {
+                    C_loc[l * k + m] += vil * W[i * k + m];
+                }
+            }
+        }
+
+        #pragma omp critical
+        {
+            for (int l = 0; l < k * k; ++l)
+                C[l] += C_loc[l];
+            for (int l = 0; l < k; ++l)
+                t[l] += t_loc[l];
+        }
+        #pragma omp barrier
+
+        #pragma omp single
+        {
+            for (int l = 0; l < k; ++l)
+                C[l * k + l] += 1.0;
+            if (!singular && !solveSmall(C, t, k))
+                singular = true;
+        }
+
+        if (!singular)
+        {
+            #pragma omp for schedule(static)
+            for (int i = 0; i < n; ++i)
+            {
+                double sum = 0.0;
+                for (int l = 0; l < k; ++l)
+                {
+                    sum += W[i * k + l] * t[l];
+                }
+                x[i] -= sum;
+            }
+        }
+    }
+    return !singular;
+}
+
+inline bool isSymmetric(const Matrix &A, int n_threads)
+{
+    int n = A.size();
+    bool ok = true;
+
+    #pragma omp parallel for reduction(&&:ok) schedule(dynamic, 16) num_threads(n_threads)
+    for (int i = 0; i < n; ++i)
+    {
+        const double *row = A[i];
+        bool row_ok = true;
+        for (int j = i + 1; j < n && row_ok; ++j)
+        {
+            if (fabs(row[j] - A[j][i]) > SYMMETRY_TOLERANCE * fmax(fabs(row[j]), fabs(A[j][i])))
+            {
+                row_ok = false;
+            }
+        }
+        ok = ok && row_ok;
+    }
+    return ok;
+}
+
+// Uses the Woodbury fast path when A is diagonal plus rank 1 (any D and u v^T, the
+// capacitance system I + V^T W is solved with pivoting, so neither has to be definite).
+// Otherwise the iterative path: CG if A is symmetric, BiCGSTAB if it is not or if CG
+// breaks down because A is not positive definite.
+// *structured tells which path was taken.
+inline Vector solveStructured(const Matrix &A, const Vector &b, double epsilon, int n_threads, bool *structured = nullptr)
+{
+    LowRankOperator op;
+    Vector x;
+    bool fast = detectDiagonalPlusRankOne(A, n_threads, &op) && woodburySolve(op, b, x, n_threads);
+    if (!fast)
+    {
+        bool breakdown = true;
+        if (isSymmetric(A, n_threads))
+        {
+            x = conjugateGradientMethod(A, b, epsilon, n_threads, nullptr, nullptr, &breakdown);
+        }
+        if (breakdown)
+        {
+            x = biCGStabMethod(A, b, epsilon, n_threads);
+        }
+    }
+    if (structured != nullptr)
+    {
+        *structured = fast;
+    }
+    return x;
+}